@@ -0,0 +1,85 @@
+#stage vertex
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// instanced counterpart of default.hlsl - one record per quad, corners are generated here
+struct vs_input {
+    [[vk::location(0)]] float2 position : POSITION0;
+    [[vk::location(1)]] float2 size : SIZE0;
+    [[vk::location(2)]] float rotation : ROTATION0;
+    [[vk::location(3)]] float4 color : COLOR0;
+    [[vk::location(4)]] int texture_index : TEXTUREINDEX0;
+
+    uint vertex_id : SV_VertexID;
+};
+
+struct vs_output {
+    float4 position : SV_POSITION;
+
+    [[vk::location(0)]] float4 color : COLOR0;
+    [[vk::location(1)]] float2 uv : TEXCOORD0;
+    [[vk::location(2)]] int texture_index : TEXTUREINDEX0; 
+};
+
+struct camera_data_t {
+    float4x4 view_projection;
+};
+ConstantBuffer<camera_data_t> camera_data : register(b0);
+
+// top right, bottom right, bottom left, top left
+static const float2 corners[4] = {
+    float2(1.f, 1.f), float2(1.f, -1.f), float2(-1.f, -1.f), float2(-1.f, 1.f)
+};
+
+static const float2 uvs[4] = {
+    float2(1.f, 0.f), float2(1.f, 1.f), float2(0.f, 1.f), float2(0.f, 0.f)
+};
+
+vs_output main(vs_input input) {
+    vs_output output;
+
+    float sin_rot, cos_rot;
+    sincos(radians(input.rotation), sin_rot, cos_rot);
+
+    float2 corner = corners[input.vertex_id] * input.size / 2.f;
+    float2 position;
+    position.x = corner.x * cos_rot - corner.y * sin_rot;
+    position.y = corner.x * sin_rot + corner.y * cos_rot;
+    position += input.position;
+
+    output.position = mul(camera_data.view_projection, float4(position, 0.f, 1.f));
+    output.color = input.color;
+    output.uv = uvs[input.vertex_id];
+    output.texture_index = input.texture_index;
+
+    return output;
+}
+
+#stage pixel
+struct ps_input {
+    [[vk::location(0)]] float4 color : COLOR0;
+    [[vk::location(1)]] float2 uv : TEXCOORD0;
+    [[vk::location(2)]] int texture_index : TEXTUREINDEX0; 
+};
+
+Texture2D textures[16] : register(t1);
+SamplerState tex_samplers[16] : register(s1);
+
+float4 main(ps_input input) : SV_TARGET {
+    float4 tex_color = textures[input.texture_index].Sample(tex_samplers[input.texture_index],
+        input.uv);
+    return tex_color * input.color;
+}
\ No newline at end of file
@@ -5,7 +5,7 @@ namespace %project%.Assets.Scripts
 {
     public sealed class ExampleScript : Script
     {
-        public void OnUpdate(Timestep ts)
+        public void OnFixedUpdate(Timestep ts)
         {
             if (!HasComponent<RigidBodyComponent>())
             {
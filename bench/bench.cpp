@@ -0,0 +1,141 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "bench_layer.h"
+#include <sge/core/main.h>
+#include <sge/core/profiler.h>
+#include <cstdlib>
+#include <new>
+
+// every heap allocation in the process is counted so that phases can report their allocations
+void* operator new(size_t size) {
+    sge::profiler::on_allocation(size);
+
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return block;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+void operator delete[](void* block, size_t) noexcept { std::free(block); }
+
+// over-aligned types don't go through the overloads above
+void* operator new(size_t size, std::align_val_t alignment) {
+    sge::profiler::on_allocation(size);
+
+    size_t block_alignment = (size_t)alignment;
+    size_t block_size = size == 0 ? 1 : size;
+
+#ifdef SGE_PLATFORM_WINDOWS
+    void* block = _aligned_malloc(block_size, block_alignment);
+#else
+    // aligned_alloc requires the size to be a multiple of the alignment
+    block_size = (block_size + block_alignment - 1) & ~(block_alignment - 1);
+    void* block = std::aligned_alloc(block_alignment, block_size);
+#endif
+
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return block;
+}
+
+void operator delete(void* block, std::align_val_t) noexcept {
+#ifdef SGE_PLATFORM_WINDOWS
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete[](void* block, std::align_val_t alignment) noexcept {
+    operator delete(block, alignment);
+}
+
+void operator delete(void* block, size_t, std::align_val_t alignment) noexcept {
+    operator delete(block, alignment);
+}
+
+void operator delete[](void* block, size_t, std::align_val_t alignment) noexcept {
+    operator delete(block, alignment);
+}
+
+namespace bench {
+    class sge_bench : public application {
+    public:
+        sge_bench() : application("SGE Bench") {}
+
+    protected:
+        virtual void pre_init() override {
+            m_start_time = std::chrono::high_resolution_clock::now();
+
+            std::vector<std::string> args;
+            get_application_args(args);
+            m_params.parse(args);
+
+            // the benchmark measures the cpu side of the engine; nothing is presented
+            renderer::set_backend(renderer_backend::null);
+
+            if (m_params.managed_script_count == 0) {
+                disable_subsystem(subsystem_script_engine);
+                disable_subsystem(subsystem_project);
+            } else {
+                script_engine::set_aot_enabled(m_params.aot);
+            }
+        }
+
+        virtual void on_init() override {
+            if (!m_params.project_path.empty()) {
+                spdlog::info("loading project: {0}", m_params.project_path.string());
+                if (!project::load(fs::absolute(m_params.project_path))) {
+                    throw std::runtime_error("could not load project!");
+                }
+            }
+
+            m_layer = new bench_layer(m_params);
+            push_layer(m_layer);
+
+            auto startup_time = std::chrono::high_resolution_clock::now() - m_start_time;
+            m_layer->set_startup_time(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(startup_time));
+        }
+
+        virtual void on_shutdown() override {
+            pop_layer(m_layer);
+            delete m_layer;
+        }
+
+    private:
+        bench_params m_params;
+        bench_layer* m_layer;
+
+        std::chrono::high_resolution_clock::time_point m_start_time;
+    };
+} // namespace bench
+
+application* create_app_instance() { return new bench::sge_bench; }
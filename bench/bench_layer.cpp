@@ -0,0 +1,319 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bench_pch.h"
+#include "bench_layer.h"
+#include <sge/asset/json.h>
+#include <sge/core/profiler.h>
+#include <sge/renderer/shader.h>
+#include <sge/renderer/texture.h>
+#include <iostream>
+
+namespace bench {
+    void bench_params::parse(const std::vector<std::string>& args) {
+        // arguments are of the form --name=value; the first argument is the executable
+        for (size_t i = 1; i < args.size(); i++) {
+            const auto& arg = args[i];
+            if (arg == "--headless") {
+                continue;
+            }
+
+            size_t separator = arg.find('=');
+            if (arg.find("--") != 0 || separator == std::string::npos) {
+                throw std::runtime_error("malformed argument: " + arg);
+            }
+
+            std::string name = arg.substr(2, separator - 2);
+            std::string value = arg.substr(separator + 1);
+
+            if (name == "sprites") {
+                sprite_count = (uint32_t)std::stoul(value);
+            } else if (name == "z-layers") {
+                z_layer_spread = (int32_t)std::stol(value);
+            } else if (name == "shaders") {
+                shader_count = (uint32_t)std::stoul(value);
+            } else if (name == "textures") {
+                texture_count = (uint32_t)std::stoul(value);
+            } else if (name == "bodies") {
+                rigid_body_count = (uint32_t)std::stoul(value);
+            } else if (name == "native-scripts") {
+                native_script_count = (uint32_t)std::stoul(value);
+            } else if (name == "managed-scripts") {
+                managed_script_count = (uint32_t)std::stoul(value);
+            } else if (name == "aot") {
+                aot = std::stoul(value) != 0;
+            } else if (name == "script-class") {
+                script_class = value;
+            } else if (name == "project") {
+                project_path = value;
+            } else if (name == "warmup") {
+                warmup_frames = (uint32_t)std::stoul(value);
+            } else if (name == "frames") {
+                frame_count = (uint32_t)std::stoul(value);
+            } else if (name == "output") {
+                output_path = value;
+            } else {
+                throw std::runtime_error("unknown argument: " + name);
+            }
+        }
+
+        if (z_layer_spread < 1) {
+            throw std::runtime_error("the z-layer spread must be at least 1!");
+        }
+
+        if (managed_script_count > 0 && (project_path.empty() || script_class.empty())) {
+            throw std::runtime_error("managed scripts require --project and --script-class!");
+        }
+    }
+
+    // stands in for gameplay code; touches its own transform every frame
+    class bench_script : public entity_script {
+    public:
+        virtual void on_update(timestep ts) override {
+            auto& transform = get_component<transform_component>();
+            transform.rotation += (float)ts.count() * 90.f;
+
+            mark_physics_dirty();
+        }
+    };
+
+    void bench_layer::on_attach() {
+        create_resources();
+        create_entities();
+
+        m_scene->set_viewport_size(1600, 900);
+        m_scene->on_start();
+
+        m_total_time = std::chrono::nanoseconds(0);
+        m_startup_time = m_first_frame_time = std::chrono::nanoseconds(0);
+        profiler::set_enabled(true);
+    }
+
+    void bench_layer::on_detach() {
+        profiler::set_enabled(false);
+        profiler::reset();
+
+        m_scene->on_stop();
+        m_scene.reset();
+
+        m_shaders.clear();
+        m_textures.clear();
+    }
+
+    void bench_layer::on_update(timestep ts) {
+        uint32_t frame_total = m_params.warmup_frames + m_params.frame_count;
+        if (m_frame >= frame_total) {
+            return;
+        }
+
+        // everything before this point is warmup
+        if (m_frame == m_params.warmup_frames) {
+            profiler::reset();
+        }
+
+        // a fixed timestep keeps physics and scripts deterministic between runs
+        static const timestep frame_time = timestep(1.0 / 60.0);
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            m_scene->on_runtime_update(frame_time);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            if (m_frame == 0) {
+                m_first_frame_time = time;
+            }
+
+            if (m_frame >= m_params.warmup_frames) {
+                m_total_time += time;
+            }
+        }
+
+        m_last_stats = renderer::get_stats();
+        if (++m_frame == frame_total) {
+            write_report();
+            application::get().quit();
+        }
+    }
+
+    void bench_layer::create_resources() {
+        // the first variant is the library's default shader, the rest are separate instances of
+        // the same source so that every variant breaks batches like a distinct shader would
+        for (uint32_t i = 1; i < m_params.shader_count; i++) {
+            m_shaders.push_back(shader::create("assets/shaders/default.hlsl"));
+        }
+
+        for (uint32_t i = 0; i < m_params.texture_count; i++) {
+            uint8_t pixel[4] = { (uint8_t)(i * 53), (uint8_t)(i * 97), (uint8_t)(i * 193), 255 };
+            auto data = image_data::create(pixel, sizeof(pixel), 1, 1, image_format::RGBA8_UNORM);
+
+            texture_spec spec;
+            spec.image = image_2d::create(data, image_usage_none);
+            spec.filter = texture_filter::nearest;
+
+            m_textures.push_back(texture_2d::create(spec));
+        }
+
+        if (m_params.managed_script_count > 0) {
+            auto assembly_index = project::get().get_assembly_index();
+            if (!assembly_index.has_value()) {
+                throw std::runtime_error("the project's script assembly is not loaded!");
+            }
+
+            void* assembly = script_engine::get_assembly(assembly_index.value());
+            m_script_class = script_engine::get_class(assembly, m_params.script_class);
+
+            if (m_script_class == nullptr) {
+                throw std::runtime_error("could not find script class: " + m_params.script_class);
+            }
+        }
+    }
+
+    void bench_layer::create_entities() {
+        m_scene = ref<scene>::create();
+
+        auto camera = m_scene->create_entity("Camera");
+        camera.add_component<camera_component>();
+
+        uint32_t entity_count = std::max({ m_params.sprite_count, m_params.rigid_body_count,
+                                           m_params.native_script_count,
+                                           m_params.managed_script_count });
+
+        // lay entities out on a square grid above a static floor so that bodies collide
+        static constexpr float spacing = 1.25f;
+        uint32_t columns = (uint32_t)std::ceil(std::sqrt((double)entity_count));
+        columns = std::max(columns, 1u);
+        float width = (float)columns * spacing;
+
+        if (m_params.rigid_body_count > 0) {
+            auto floor = m_scene->create_entity("Floor");
+
+            auto& transform = floor.get_component<transform_component>();
+            transform.translation = glm::vec2(width / 2.f, -spacing);
+            transform.scale = glm::vec2(width, 1.f);
+
+            floor.add_component<rigid_body_component>(rigid_body_component::body_type::static_);
+            floor.add_component<box_collider_component>();
+        }
+
+        for (uint32_t i = 0; i < entity_count; i++) {
+            auto e = m_scene->create_entity("Entity " + std::to_string(i));
+
+            auto& transform = e.get_component<transform_component>();
+            transform.translation.x = (float)(i % columns) * spacing;
+            transform.translation.y = (float)(i / columns) * spacing;
+            transform.z_layer = (int32_t)(i % (uint32_t)m_params.z_layer_spread);
+
+            if (i < m_params.sprite_count) {
+                auto& sprite = e.add_component<sprite_renderer_component>();
+                sprite.color = glm::vec4((float)(i % 7) / 6.f, (float)(i % 11) / 10.f, 1.f, 1.f);
+
+                // variants are interleaved so that neighbouring sprites break batches
+                if (m_params.shader_count > 1) {
+                    uint32_t variant = i % m_params.shader_count;
+                    if (variant > 0) {
+                        sprite._shader = m_shaders[variant - 1];
+                    }
+                }
+
+                if (!m_textures.empty()) {
+                    sprite.texture = m_textures[i % m_textures.size()];
+                }
+            }
+
+            if (i < m_params.rigid_body_count) {
+                e.add_component<rigid_body_component>(rigid_body_component::body_type::dynamic);
+                e.add_component<box_collider_component>();
+            }
+
+            if (i < m_params.native_script_count) {
+                e.add_component<native_script_component>().bind<bench_script>();
+            }
+
+            if (i < m_params.managed_script_count) {
+                m_scene->set_script(e, m_script_class);
+            }
+        }
+    }
+
+    void bench_layer::write_report() {
+        using namespace std::chrono;
+        auto to_ms = [](nanoseconds time) { return duration<double, std::milli>(time).count(); };
+
+        double frame_count = (double)m_params.frame_count;
+        json report;
+
+        report["engine_version"] = application::get_engine_version();
+        report["device"] = renderer::query_device_info().name;
+
+        json params;
+        params["sprites"] = m_params.sprite_count;
+        params["z_layers"] = m_params.z_layer_spread;
+        params["shaders"] = m_params.shader_count;
+        params["textures"] = m_params.texture_count;
+        params["bodies"] = m_params.rigid_body_count;
+        params["native_scripts"] = m_params.native_script_count;
+        params["managed_scripts"] = m_params.managed_script_count;
+        params["aot"] = m_params.aot;
+        params["warmup"] = m_params.warmup_frames;
+        params["frames"] = m_params.frame_count;
+        report["params"] = params;
+
+        // compare runs with --aot=0 and --aot=1 to see what precompiling the assemblies saves.
+        // the first frame is where jitted scripts pay for compiling their update methods
+        json startup;
+        startup["aot"] = m_params.managed_script_count > 0 && script_engine::is_aot_enabled();
+        startup["startup_ms"] = to_ms(m_startup_time);
+        startup["first_frame_ms"] = to_ms(m_first_frame_time);
+        report["startup"] = startup;
+
+        report["total_ms"] = to_ms(m_total_time);
+        report["frame_ms"] = to_ms(m_total_time) / frame_count;
+
+        // batch_flush is nested in render_order and physics_sync is recorded on both sides of
+        // the step, so phase times do not add up to frame_ms
+        json phases;
+        for (const auto& phase : profiler::get_phases()) {
+            json data;
+            data["calls"] = phase.calls;
+            data["total_ms"] = to_ms(phase.time);
+            data["ms_per_frame"] = to_ms(phase.time) / frame_count;
+            data["allocations"] = phase.allocations;
+            data["allocations_per_frame"] = (double)phase.allocations / frame_count;
+            data["allocated_bytes"] = phase.allocated_bytes;
+
+            phases[phase.name] = data;
+        }
+        report["phases"] = phases;
+
+        json stats;
+        stats["draw_calls"] = m_last_stats.draw_calls;
+        stats["quads"] = m_last_stats.quad_count;
+        stats["vertices"] = m_last_stats.vertex_count;
+        stats["instances"] = m_last_stats.instance_count;
+        report["last_frame"] = stats;
+
+        std::string output = report.dump(4);
+        if (m_params.output_path == "-") {
+            std::cout << output << std::endl;
+        } else {
+            std::ofstream stream(m_params.output_path);
+            stream << output << std::endl;
+            stream.close();
+
+            spdlog::info("wrote benchmark report to {0}", m_params.output_path.string());
+        }
+    }
+} // namespace bench
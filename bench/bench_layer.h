@@ -0,0 +1,77 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include <sge/renderer/renderer.h>
+
+namespace bench {
+    struct bench_params {
+        uint32_t sprite_count = 10000;
+        int32_t z_layer_spread = 8;
+        uint32_t shader_count = 1;
+        uint32_t texture_count = 4;
+        uint32_t rigid_body_count = 500;
+        uint32_t native_script_count = 100;
+        uint32_t managed_script_count = 0;
+
+        // 0 forces the script engine to jit, even if precompiled images were built
+        bool aot = true;
+
+        // fully qualified name of a class in the project's script assembly
+        std::string script_class;
+        fs::path project_path;
+
+        uint32_t warmup_frames = 60;
+        uint32_t frame_count = 600;
+
+        // "-" writes the report to stdout
+        fs::path output_path = "bench.json";
+
+        void parse(const std::vector<std::string>& args);
+    };
+
+    // Builds a synthetic scene from the given parameters, drives it for the requested number of
+    // frames and writes per-phase timings and allocations as JSON before quitting.
+    class bench_layer : public layer {
+    public:
+        bench_layer(const bench_params& params) : layer("Bench"), m_params(params) {}
+
+        virtual void on_attach() override;
+        virtual void on_detach() override;
+
+        virtual void on_update(timestep ts) override;
+
+        // time from application startup until the scene was started
+        void set_startup_time(std::chrono::nanoseconds time) { m_startup_time = time; }
+
+    private:
+        void create_resources();
+        void create_entities();
+        void write_report();
+
+        bench_params m_params;
+        ref<scene> m_scene;
+
+        std::vector<ref<shader>> m_shaders;
+        std::vector<ref<texture_2d>> m_textures;
+        void* m_script_class = nullptr;
+
+        uint32_t m_frame = 0;
+        std::chrono::nanoseconds m_total_time;
+        std::chrono::nanoseconds m_startup_time, m_first_frame_time;
+        renderer::stats m_last_stats;
+    };
+} // namespace bench
@@ -0,0 +1,25 @@
+# searches for the Mono runtime executable, used to precompile managed assemblies. the install
+# prefix of vendor/mono/build.py is searched first, since precompiled images only load in the
+# runtime version that built them
+
+find_program(MONO_EXE "mono"
+    HINTS "/usr/local/"
+    PATHS "/Library/Frameworks/Mono.framework/Versions/Current/" "/usr/" "C:\\Program Files\\Mono\\"
+    PATH_SUFFIXES "bin/")
+
+if(MONO_EXE)
+    execute_process(COMMAND ${MONO_EXE} --version
+        OUTPUT_VARIABLE MONO_VERSION_OUTPUT
+        ERROR_QUIET)
+
+    string(REGEX MATCH "version ([0-9]+(\\.[0-9]+)+)" MONO_VERSION_MATCH "${MONO_VERSION_OUTPUT}")
+    set(MONO_VERSION ${CMAKE_MATCH_1})
+endif()
+
+set(MONO_REQUIRED_VARS MONO_EXE MONO_VERSION)
+mark_as_advanced(MONO_EXE)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Mono
+    REQUIRED_VARS ${MONO_REQUIRED_VARS}
+    VERSION_VAR MONO_VERSION)
@@ -0,0 +1,131 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System;
+
+namespace SGE
+{
+    /// <summary>
+    /// Every component of one type in a scene, accessed in place. Elements are references into
+    /// native storage: they stay valid until a component of the type is added or removed, after
+    /// which the view must be refreshed.
+    /// </summary>
+    /// <typeparam name="T">
+    /// The component data type, e.g. <see cref="Components.TransformData"/>.
+    /// </typeparam>
+    public sealed class ComponentView<T> where T : unmanaged
+    {
+        internal ComponentView(Scene scene)
+        {
+            mScene = scene;
+            Refresh();
+        }
+
+        /// <summary>
+        /// Submits pending changes and gathers the components of the scene again.
+        /// </summary>
+        public void Refresh()
+        {
+            SubmitChanges();
+
+            int count = CoreInternalCalls.GetComponentView(typeof(T), mScene.mNativeAddress, mEntityIDs, mAddresses);
+            if (count > mAddresses.Length)
+            {
+                mEntityIDs = new uint[count];
+                mAddresses = new IntPtr[count];
+
+                count = CoreInternalCalls.GetComponentView(typeof(T), mScene.mNativeAddress, mEntityIDs, mAddresses);
+            }
+
+            mCount = count;
+        }
+
+        /// <summary>
+        /// Marks a component as changed. Changes are reported to the scene, which keeps physics and
+        /// rendering in sync with them, on the next call to <see cref="SubmitChanges"/>.
+        /// </summary>
+        /// <param name="index">The index of the changed component.</param>
+        public void MarkChanged(int index)
+        {
+            VerifyIndex(index);
+
+            if (mChangedCount == mChangedIDs.Length)
+            {
+                Array.Resize(ref mChangedIDs, Math.Max(mChangedIDs.Length * 2, 16));
+            }
+
+            mChangedIDs[mChangedCount++] = mEntityIDs[index];
+        }
+
+        /// <summary>
+        /// Reports every component marked as changed to the scene.
+        /// </summary>
+        public void SubmitChanges()
+        {
+            if (mChangedCount > 0)
+            {
+                CoreInternalCalls.PatchComponents(typeof(T), mScene.mNativeAddress, mChangedIDs, mChangedCount);
+                mChangedCount = 0;
+            }
+        }
+
+        /// <summary>
+        /// Gets the entity that owns a component.
+        /// </summary>
+        /// <param name="index">The index of the component.</param>
+        /// <returns>The entity.</returns>
+        public Entity GetEntity(int index)
+        {
+            VerifyIndex(index);
+            return new Entity(mEntityIDs[index], mScene);
+        }
+
+        /// <summary>
+        /// The component at an index, in native storage. Changes must be reported with
+        /// <see cref="MarkChanged(int)"/>.
+        /// </summary>
+        /// <param name="index">The index of the component.</param>
+        public unsafe ref T this[int index]
+        {
+            get
+            {
+                VerifyIndex(index);
+                return ref *(T*)mAddresses[index];
+            }
+        }
+
+        /// <summary>
+        /// The number of components in this view.
+        /// </summary>
+        public int Count => mCount;
+
+        private void VerifyIndex(int index)
+        {
+            if ((uint)index >= (uint)mCount)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+        }
+
+        private readonly Scene mScene;
+        private uint[] mEntityIDs = new uint[0];
+        private IntPtr[] mAddresses = new IntPtr[0];
+        private int mCount = 0;
+
+        private uint[] mChangedIDs = new uint[0];
+        private int mChangedCount = 0;
+    }
+}
@@ -0,0 +1,60 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System.Runtime.InteropServices;
+
+namespace SGE.Components
+{
+    // These map directly onto the native component structs, so that whole views of them can be
+    // read and written in place through a ComponentView. Field order and sizes must not change.
+
+    /// <summary>
+    /// The data of a <see cref="TransformComponent"/>. Maps to sge::transform_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TransformData
+    {
+        public Vector2 Translation;
+        public int ZLayer;
+        public float Rotation;
+        public Vector2 Scale;
+    }
+
+    /// <summary>
+    /// The data of a <see cref="RigidBodyComponent"/>. Maps to sge::rigid_body_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RigidBodyData
+    {
+        public BodyType BodyType;
+        public bool FixedRotation;
+        public ushort CategoryBits;
+        public ushort MaskBits;
+    }
+
+    /// <summary>
+    /// The data of a <see cref="BoxColliderComponent"/>. Maps to sge::box_collider_component.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct BoxColliderData
+    {
+        public Vector2 Size;
+        public float Density;
+        public float Friction;
+        public float Restitution;
+        public float RestitutionThreshold;
+    }
+}
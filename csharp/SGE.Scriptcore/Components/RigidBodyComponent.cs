@@ -149,7 +149,7 @@ namespace SGE.Components
         public ushort CategoryBits
         {
             get => CoreInternalCalls.GetFilterCategory(mComponent.Address);
-            set => CoreInternalCalls.SetFilterCategory(mComponent.Address, value);
+            set => CoreInternalCalls.SetFilterCategory(mComponent.Address, mComponent.Parent, value);
         }
 
         /// <summary>
@@ -158,7 +158,7 @@ namespace SGE.Components
         public ushort MaskBits
         {
             get => CoreInternalCalls.GetFilterMask(mComponent.Address);
-            set => CoreInternalCalls.SetFilterMask(mComponent.Address, value);
+            set => CoreInternalCalls.SetFilterMask(mComponent.Address, mComponent.Parent, value);
         }
 
         private readonly RigidBodyComponent mComponent;
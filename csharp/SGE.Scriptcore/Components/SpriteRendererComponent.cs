@@ -56,7 +56,7 @@ namespace SGE.Components
                     address = value.mAddress;
                 }
 
-                CoreInternalCalls.SetTexture(mAddress, address);
+                CoreInternalCalls.SetTexture(mAddress, Parent, address);
             }
         }
 
@@ -29,13 +29,13 @@ namespace SGE.Components
                 CoreInternalCalls.GetTranslation(mAddress, out translation);
                 return translation;
             }
-            set => CoreInternalCalls.SetTranslation(mAddress, value);
+            set => CoreInternalCalls.SetTranslation(mAddress, Parent, value);
         }
 
         public float Rotation
         {
             get => CoreInternalCalls.GetRotation(mAddress);
-            set => CoreInternalCalls.SetRotation(mAddress, value);
+            set => CoreInternalCalls.SetRotation(mAddress, Parent, value);
         }
 
         public Vector2 Scale
@@ -46,7 +46,7 @@ namespace SGE.Components
                 CoreInternalCalls.GetScale(mAddress, out scale);
                 return scale;
             }
-            set => CoreInternalCalls.SetScale(mAddress, value);
+            set => CoreInternalCalls.SetScale(mAddress, Parent, value);
         }
 
         public int ZLayer
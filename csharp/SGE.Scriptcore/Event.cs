@@ -30,7 +30,8 @@ namespace SGE
         MouseMoved,
         MouseScrolled,
         MouseButton,
-        FileChanged
+        FileChanged,
+        ScriptCompile
     }
 
     public abstract class Event
@@ -116,6 +116,16 @@ namespace SGE
         public static extern void ForEach(Delegate callback, IntPtr scene);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern string GetCollisionCategoryName(IntPtr scene, int index);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int GetComponentView(Type dataType, IntPtr scene, uint[] entityIDs, IntPtr[] addresses);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void PatchComponents(Type dataType, IntPtr scene, uint[] entityIDs, int count);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int Raycast(IntPtr scene, Vector2 start, Vector2 end, ushort mask, RaycastHit[] hits);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int QueryAABB(IntPtr scene, Vector2 min, Vector2 max, ushort mask, uint[] entityIDs, int capacity);
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int OverlapBox(IntPtr scene, Vector2 center, Vector2 halfExtents, float rotation, ushort mask, uint[] entityIDs, int capacity);
 
         // entity
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -141,15 +151,15 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetTranslation(IntPtr component, out Vector2 translation);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetTranslation(IntPtr component, Vector2 translation);
+        public static extern void SetTranslation(IntPtr component, Entity entity, Vector2 translation);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern float GetRotation(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetRotation(IntPtr component, float rotation);
+        public static extern void SetRotation(IntPtr component, Entity entity, float rotation);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetScale(IntPtr component, out Vector2 scale);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetScale(IntPtr component, Vector2 scale);
+        public static extern void SetScale(IntPtr component, Entity entity, Vector2 scale);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern int GetZLayer(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -163,7 +173,7 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetTexture(IntPtr component, out IntPtr texture);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetTexture(IntPtr component, IntPtr texture);
+        public static extern void SetTexture(IntPtr component, Entity entity, IntPtr texture);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void GetShader(IntPtr component, out IntPtr shader);
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -231,11 +241,11 @@ namespace SGE
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern ushort GetFilterCategory(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetFilterCategory(IntPtr component, ushort category);
+        public static extern void SetFilterCategory(IntPtr component, Entity entity, ushort category);
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern ushort GetFilterMask(IntPtr component);
         [MethodImpl(MethodImplOptions.InternalCall)]
-        public static extern void SetFilterMask(IntPtr component, ushort mask);
+        public static extern void SetFilterMask(IntPtr component, Entity entity, ushort mask);
 
         // box collider component
         [MethodImpl(MethodImplOptions.InternalCall)]
@@ -0,0 +1,52 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace SGE
+{
+    /// <summary>
+    /// A collider hit by <see cref="Scene.Raycast(Vector2, Vector2, RaycastHit[], ushort)"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct RaycastHit
+    {
+        /// <summary>
+        /// The entity that owns the collider that was hit.
+        /// </summary>
+        public Entity Entity => new Entity(mEntityID, new Scene(mScene));
+
+        /// <summary>
+        /// The point at which the ray entered the collider, in world space.
+        /// </summary>
+        public Vector2 Point;
+
+        /// <summary>
+        /// The surface normal of the collider at <see cref="Point"/>.
+        /// </summary>
+        public Vector2 Normal;
+
+        /// <summary>
+        /// How far along the ray the hit is, from 0 at the start to 1 at the end.
+        /// </summary>
+        public float Fraction;
+
+        // written by native code; the layout must stay in sync with internal_calls.cpp
+        internal IntPtr mScene;
+        internal uint mEntityID;
+    }
+}
@@ -170,6 +170,82 @@ namespace SGE
         /// <param name="callback">The callback called on every iteration.</param>
         public void ForEach(Action<Entity> callback) => CoreInternalCalls.ForEach(callback, mNativeAddress);
 
+        /// <summary>
+        /// Gathers every component of a type for bulk access.
+        /// </summary>
+        /// <typeparam name="T">
+        /// The component data type: <see cref="Components.TransformData"/>,
+        /// <see cref="Components.RigidBodyData"/> or <see cref="Components.BoxColliderData"/>.
+        /// </typeparam>
+        /// <returns>A view that can be kept and refreshed.</returns>
+        public ComponentView<T> GetComponentView<T>() where T : unmanaged => new ComponentView<T>(this);
+
+        /// <summary>
+        /// Casts a ray against the colliders in the scene.
+        /// </summary>
+        /// <param name="start">The point at which the ray starts.</param>
+        /// <param name="end">The point at which the ray ends.</param>
+        /// <param name="hits">The array to write the closest hits into, sorted by distance.</param>
+        /// <param name="mask">The collision categories to test against.</param>
+        /// <returns>The number of hits written.</returns>
+        public int Raycast(Vector2 start, Vector2 end, RaycastHit[] hits, ushort mask = 0xffff)
+        {
+            return CoreInternalCalls.Raycast(mNativeAddress, start, end, mask, hits);
+        }
+
+        /// <summary>
+        /// Finds the entities whose colliders overlap an axis-aligned box.
+        /// </summary>
+        /// <param name="min">The lower corner of the box.</param>
+        /// <param name="max">The upper corner of the box.</param>
+        /// <param name="entities">The array to write the found entities into.</param>
+        /// <param name="mask">The collision categories to test against.</param>
+        /// <returns>The number of entities written.</returns>
+        public int QueryAABB(Vector2 min, Vector2 max, Entity[] entities, ushort mask = 0xffff)
+        {
+            uint[] entityIDs = GetQueryBuffer(entities.Length);
+            int count = CoreInternalCalls.QueryAABB(mNativeAddress, min, max, mask, entityIDs, entities.Length);
+
+            return WriteQueryResults(entityIDs, count, entities);
+        }
+
+        /// <summary>
+        /// Finds the entities whose colliders overlap a rotated box.
+        /// </summary>
+        /// <param name="center">The center of the box.</param>
+        /// <param name="halfExtents">Half of the width and height of the box.</param>
+        /// <param name="rotation">The rotation of the box, in degrees.</param>
+        /// <param name="entities">The array to write the found entities into.</param>
+        /// <param name="mask">The collision categories to test against.</param>
+        /// <returns>The number of entities written.</returns>
+        public int OverlapBox(Vector2 center, Vector2 halfExtents, float rotation, Entity[] entities, ushort mask = 0xffff)
+        {
+            uint[] entityIDs = GetQueryBuffer(entities.Length);
+            int count = CoreInternalCalls.OverlapBox(mNativeAddress, center, halfExtents, rotation, mask, entityIDs, entities.Length);
+
+            return WriteQueryResults(entityIDs, count, entities);
+        }
+
+        private static uint[] GetQueryBuffer(int length)
+        {
+            if (mQueryBuffer == null || mQueryBuffer.Length < length)
+            {
+                mQueryBuffer = new uint[length];
+            }
+
+            return mQueryBuffer;
+        }
+
+        private int WriteQueryResults(uint[] entityIDs, int count, Entity[] entities)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                entities[i] = new Entity(entityIDs[i], this);
+            }
+
+            return count;
+        }
+
         /// <summary>
         /// The names of the collision categories in this scene.
         /// If one doesn't have a name, it's corresponding element is empty.
@@ -208,5 +284,9 @@ namespace SGE
         public static bool operator !=(Scene lhs, Scene rhs) => !(lhs == rhs);
 
         internal readonly IntPtr mNativeAddress;
+
+        // entity ids are written here by native queries, so that they cross over in one call
+        [ThreadStatic]
+        private static uint[] mQueryBuffer;
     }
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+using System;
+using System.Reflection;
+
+namespace SGE
+{
+    /// <summary>
+    /// Calls an update method on every instance of one script class, so that the engine makes
+    /// one managed call per class instead of one per script.
+    /// </summary>
+    internal abstract class ScriptDispatcher
+    {
+        public abstract void Dispatch(Script[] scripts, int count, Timestep ts);
+
+        internal static ScriptDispatcher Create(Type scriptType, string methodName)
+        {
+            if (!typeof(Script).IsAssignableFrom(scriptType) || scriptType.IsAbstract)
+            {
+                return null;
+            }
+
+            var flags = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic;
+            var method = scriptType.GetMethod(methodName, flags, null, new Type[] { typeof(Timestep) }, null);
+            if (method == null || method.ReturnType != typeof(void))
+            {
+                return null;
+            }
+
+            Type dispatcherType = typeof(ScriptDispatcher<>).MakeGenericType(scriptType);
+            return (ScriptDispatcher)Activator.CreateInstance(dispatcherType, method);
+        }
+    }
+
+    internal sealed class ScriptDispatcher<T> : ScriptDispatcher where T : Script
+    {
+        public ScriptDispatcher(MethodInfo method)
+        {
+            mCallback = (Action<T, Timestep>)Delegate.CreateDelegate(typeof(Action<T, Timestep>), method);
+        }
+
+        public override void Dispatch(Script[] scripts, int count, Timestep ts)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                // one script throwing shouldn't stop the rest of the batch
+                try
+                {
+                    mCallback((T)scripts[i], ts);
+                }
+                catch (Exception exception)
+                {
+                    Helpers.ReportException(exception);
+                }
+            }
+        }
+
+        private readonly Action<T, Timestep> mCallback;
+    }
+}
@@ -28,12 +28,14 @@
 #include "sge/core/application.h"
 #include "sge/core/environment.h"
 #include "sge/core/input.h"
+#include "sge/core/profiler.h"
 #include "sge/core/window.h"
 
 // events
 #include "sge/events/event.h"
 #include "sge/events/window_events.h"
 #include "sge/events/input_events.h"
+#include "sge/events/script_events.h"
 
 // imgui extensions
 #include "sge/imgui/imgui_extensions.h"
@@ -19,6 +19,7 @@
 #include "sge/asset/json.h"
 #include "sge/core/application.h"
 #include "sge/core/environment.h"
+#include "sge/renderer/renderer.h"
 #include "sge/script/script_engine.h"
 
 namespace sge {
@@ -45,6 +46,10 @@ namespace sge {
             spdlog::warn("projects have not been initalized!");
         }
 
+        if (s_project_data && loaded()) {
+            renderer::save_pipeline_cache(get().get_pipeline_cache_path());
+        }
+
         s_project_data.reset();
     }
 
@@ -136,15 +141,17 @@ namespace sge {
         }
         instance.m_start_scene = start_scene;
 
+        renderer::load_pipeline_cache(instance.get_pipeline_cache_path());
         reload_assembly({});
         return true;
     }
 
-    void project::reload_assembly(const std::vector<ref<scene>>& active_scenes) {
+    void project::reload_assembly(const std::vector<ref<scene>>& active_scenes,
+                                  bool compile_assembly) {
         auto& instance = get();
         auto compile = [&]() {
             bool load = true;
-            if (is_editor()) {
+            if (compile_assembly && is_editor()) {
                 load = script_engine::compile_app_assembly();
             }
 
@@ -31,7 +31,9 @@ namespace sge {
 
         static bool save();
         static bool load(const fs::path& path);
-        static void reload_assembly(const std::vector<ref<scene>>& active_scenes);
+        // if compile is false, the assembly on disk is loaded as-is
+        static void reload_assembly(const std::vector<ref<scene>>& active_scenes,
+                                    bool compile = true);
 
         project(const project&) = delete;
         project& operator=(const project&) = delete;
@@ -50,6 +52,15 @@ namespace sge {
             return get_directory() / "bin" / get_config() / "ScriptAssembly.dll";
         }
 
+        // hashes of the sources the app assembly was last built from
+        fs::path get_assembly_hash_path() {
+            return get_directory() / "bin" / get_config() / "ScriptAssembly.hash";
+        }
+
+        fs::path get_pipeline_cache_path() {
+            return get_directory() / "bin" / "pipeline_cache.bin";
+        }
+
         std::optional<size_t> get_assembly_index() { return m_assembly_index; }
 
     private:
@@ -20,6 +20,7 @@
 #include "sge/core/input.h"
 #include "sge/imgui/imgui_layer.h"
 #include "sge/script/script_engine.h"
+#include "sge/script/garbage_collector.h"
 #include "sge/asset/asset_serializers.h"
 #include "sge/asset/project.h"
 
@@ -92,6 +93,23 @@ namespace sge {
         }
     }
 
+    void application::post_event(std::unique_ptr<event> e) {
+        std::lock_guard lock(m_posted_events_mutex);
+        m_posted_events.push_back(std::move(e));
+    }
+
+    void application::process_posted_events() {
+        std::vector<std::unique_ptr<event>> events;
+        {
+            std::lock_guard lock(m_posted_events_mutex);
+            events.swap(m_posted_events);
+        }
+
+        for (const auto& e : events) {
+            on_event(*e);
+        }
+    }
+
     bool application::is_watching(const fs::path& path) {
         if (path.empty()) {
             return false;
@@ -139,6 +157,12 @@ namespace sge {
         spdlog::info("using SGE v{0}", get_engine_version());
         spdlog::info("initializing application: {0}...", m_title);
 
+        for (const auto& arg : m_args) {
+            if (arg == "--headless") {
+                renderer::set_backend(renderer_backend::null);
+            }
+        }
+
         pre_init();
         if ((m_disabled_subsystems & subsystem_input) == 0) {
             input::init();
@@ -228,10 +252,15 @@ namespace sge {
                 watcher->process_events(SGE_BIND_EVENT_FUNC(application::on_event));
             }
 
+            process_posted_events();
+
             if (!m_minimized) {
                 m_swapchain->new_frame();
                 renderer::new_frame();
 
+                // acquiring and presenting images may block on vsync
+                auto work_start = std::chrono::high_resolution_clock::now();
+
                 size_t current_image = m_swapchain->get_current_image_index();
                 auto& cmdlist = m_swapchain->get_command_list(current_image);
                 cmdlist.begin();
@@ -268,7 +297,13 @@ namespace sge {
                 }
                 cmdlist.end();
 
+                auto work_end = std::chrono::high_resolution_clock::now();
                 m_swapchain->present();
+
+                if (is_subsystem_initialized(subsystem_script_engine)) {
+                    garbage_collector::end_frame(
+                        std::chrono::duration_cast<timestep>(work_end - work_start));
+                }
             }
 
             m_window->on_update();
@@ -53,6 +53,10 @@ namespace sge {
         void quit() { m_running = false; }
         void on_event(event& e);
 
+        // may be called from any thread. posted events are dispatched from the main thread at the
+        // start of the next frame
+        void post_event(std::unique_ptr<event> e);
+
         void set_application_args(const std::vector<std::string>& args) { m_args = args; }
         void get_application_args(std::vector<std::string>& args) { args = m_args; }
 
@@ -99,10 +103,15 @@ namespace sge {
 
         void init_logger();
 
+        void process_posted_events();
+
         bool on_window_resize(window_resize_event& e);
         bool on_window_close(window_close_event& e);
 
         uint32_t m_disabled_subsystems = 0;
         uint32_t m_initialized_subsystems = 0;
+
+        std::mutex m_posted_events_mutex;
+        std::vector<std::unique_ptr<event>> m_posted_events;
     };
 } // namespace sge
\ No newline at end of file
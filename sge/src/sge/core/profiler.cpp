@@ -0,0 +1,100 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/core/profiler.h"
+#include <atomic>
+#include <cstring>
+namespace sge {
+    static bool s_enabled = false;
+    static std::vector<profiler::phase_data> s_phases;
+
+    static std::atomic<size_t> s_allocation_count = 0;
+    static std::atomic<size_t> s_allocated_bytes = 0;
+
+    void profiler::set_enabled(bool enabled) { s_enabled = enabled; }
+    bool profiler::is_enabled() { return s_enabled; }
+
+    void profiler::on_allocation(size_t size) {
+        s_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        s_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    size_t profiler::get_allocation_count() {
+        return s_allocation_count.load(std::memory_order_relaxed);
+    }
+
+    size_t profiler::get_allocated_bytes() {
+        return s_allocated_bytes.load(std::memory_order_relaxed);
+    }
+
+    void profiler::record(const char* phase, std::chrono::nanoseconds time, size_t allocations,
+                          size_t allocated_bytes) {
+        if (!s_enabled) {
+            return;
+        }
+
+        // a handful of phases per frame - a linear search beats hashing the name
+        phase_data* data = nullptr;
+        for (auto& existing : s_phases) {
+            if (existing.name == phase || strcmp(existing.name, phase) == 0) {
+                data = &existing;
+                break;
+            }
+        }
+
+        if (data == nullptr) {
+            data = &s_phases.emplace_back();
+            data->name = phase;
+            data->calls = 0;
+            data->time = std::chrono::nanoseconds(0);
+            data->allocations = 0;
+            data->allocated_bytes = 0;
+        }
+
+        data->calls++;
+        data->time += time;
+        data->allocations += allocations;
+        data->allocated_bytes += allocated_bytes;
+    }
+
+    void profiler::reset() { s_phases.clear(); }
+    const std::vector<profiler::phase_data>& profiler::get_phases() { return s_phases; }
+
+    profiler_scope::profiler_scope(const char* phase) {
+        m_phase = phase;
+        m_enabled = profiler::is_enabled();
+
+        if (m_enabled) {
+            m_allocations = profiler::get_allocation_count();
+            m_allocated_bytes = profiler::get_allocated_bytes();
+            m_start = std::chrono::high_resolution_clock::now();
+        }
+    }
+
+    profiler_scope::~profiler_scope() {
+        if (!m_enabled) {
+            return;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        size_t allocations = profiler::get_allocation_count() - m_allocations;
+        size_t allocated_bytes = profiler::get_allocated_bytes() - m_allocated_bytes;
+
+        auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start);
+        profiler::record(m_phase, time, allocations, allocated_bytes);
+    }
+} // namespace sge
@@ -0,0 +1,65 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+namespace sge {
+    // Accumulates wall time and heap allocations per named phase. Disabled by default, in which
+    // case scopes cost a single branch. Allocations are only counted if the executable forwards
+    // its global operator new to on_allocation. Phases must be recorded from the main thread.
+    class profiler {
+    public:
+        struct phase_data {
+            const char* name;
+            size_t calls;
+            std::chrono::nanoseconds time;
+
+            size_t allocations;
+            size_t allocated_bytes;
+        };
+
+        profiler() = delete;
+
+        static void set_enabled(bool enabled);
+        static bool is_enabled();
+
+        static void on_allocation(size_t size);
+        static size_t get_allocation_count();
+        static size_t get_allocated_bytes();
+
+        static void record(const char* phase, std::chrono::nanoseconds time, size_t allocations,
+                           size_t allocated_bytes);
+
+        static void reset();
+        static const std::vector<phase_data>& get_phases();
+    };
+
+    class profiler_scope {
+    public:
+        // phase must be a string literal; phases are matched by name
+        profiler_scope(const char* phase);
+        ~profiler_scope();
+
+        profiler_scope(const profiler_scope&) = delete;
+        profiler_scope& operator=(const profiler_scope&) = delete;
+
+    private:
+        const char* m_phase;
+        bool m_enabled;
+
+        std::chrono::high_resolution_clock::time_point m_start;
+        size_t m_allocations, m_allocated_bytes;
+    };
+} // namespace sge
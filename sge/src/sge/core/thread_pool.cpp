@@ -0,0 +1,138 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/core/thread_pool.h"
+namespace sge {
+    thread_pool::thread_pool(size_t thread_count) {
+        m_running = true;
+
+        for (size_t i = 0; i < thread_count; i++) {
+            m_threads.emplace_back([this]() { worker(); });
+        }
+    }
+
+    thread_pool::~thread_pool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_running = false;
+        }
+
+        m_condition.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void thread_pool::submit(const std::function<void()>& job) {
+        if (m_threads.empty()) {
+            job();
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push(job);
+        }
+
+        m_condition.notify_one();
+    }
+
+    void thread_pool::parallel_for(size_t count, size_t min_range_size,
+                                   const std::function<void(size_t, size_t)>& callback) {
+        if (count == 0) {
+            return;
+        }
+
+        size_t range_size = std::max(min_range_size, (size_t)1);
+        size_t range_count = (count + range_size - 1) / range_size;
+        range_count = std::clamp(range_count, (size_t)1, m_threads.size() + 1);
+
+        if (range_count == 1) {
+            callback(0, count);
+            return;
+        }
+
+        struct completion_t {
+            std::mutex mutex;
+            std::condition_variable condition;
+            size_t remaining;
+
+            // the first exception thrown by any range, rethrown once every range has finished
+            std::exception_ptr exception;
+        } completion;
+        completion.remaining = range_count - 1;
+
+        auto run_range = [&](size_t begin, size_t end) {
+            try {
+                callback(begin, end);
+            } catch (...) {
+                std::lock_guard lock(completion.mutex);
+                if (!completion.exception) {
+                    completion.exception = std::current_exception();
+                }
+            }
+        };
+
+        range_size = count / range_count;
+        for (size_t i = 1; i < range_count; i++) {
+            size_t begin = i * range_size;
+            size_t end = (i == range_count - 1) ? count : begin + range_size;
+
+            submit([&, begin, end]() {
+                run_range(begin, end);
+
+                std::lock_guard lock(completion.mutex);
+                if (--completion.remaining == 0) {
+                    completion.condition.notify_one();
+                }
+            });
+        }
+
+        run_range(0, range_size);
+
+        std::unique_lock lock(completion.mutex);
+        completion.condition.wait(lock, [&]() { return completion.remaining == 0; });
+
+        if (completion.exception) {
+            std::rethrow_exception(completion.exception);
+        }
+    }
+
+    void thread_pool::worker() {
+        while (true) {
+            std::function<void()> job;
+
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this]() { return !m_running || !m_jobs.empty(); });
+
+                if (!m_running && m_jobs.empty()) {
+                    return;
+                }
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop();
+            }
+
+            try {
+                job();
+            } catch (const std::exception& exc) {
+                spdlog::error("worker thread: {0}", exc.what());
+            }
+        }
+    }
+} // namespace sge
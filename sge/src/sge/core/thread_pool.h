@@ -0,0 +1,47 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include <condition_variable>
+
+namespace sge {
+    class thread_pool {
+    public:
+        thread_pool(size_t thread_count);
+        ~thread_pool();
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        size_t get_thread_count() { return m_threads.size(); }
+
+        void submit(const std::function<void()>& job);
+
+        // Splits [0, count) into contiguous ranges of at least min_range_size elements and runs
+        // them across the pool and the calling thread. Returns once every range has finished.
+        void parallel_for(size_t count, size_t min_range_size,
+                          const std::function<void(size_t, size_t)>& callback);
+
+    private:
+        void worker();
+
+        std::vector<std::thread> m_threads;
+        std::queue<std::function<void()>> m_jobs;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_running;
+    };
+} // namespace sge
@@ -16,11 +16,17 @@
 
 #include "sgepch.h"
 #include "sge/core/window.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_window.h"
 #ifdef SGE_PLATFORM_DESKTOP
 #include "sge/platform/desktop/desktop_window.h"
 #endif
 namespace sge {
     ref<window> window::create(const std::string& title, uint32_t width, uint32_t height) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_window>::create(title, width, height);
+        }
+
 #ifdef SGE_PLATFORM_DESKTOP
         return ref<desktop_window>::create(title, width, height);
 #endif
@@ -26,7 +26,8 @@ namespace sge {
         mouse_moved,
         mouse_scrolled,
         mouse_button,
-        file_changed
+        file_changed,
+        script_compile
     };
 
 #define EVENT_ID_DECL(id)                                                                          \
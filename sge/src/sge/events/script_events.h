@@ -0,0 +1,39 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/events/event.h"
+namespace sge {
+    enum class script_compile_status : int32_t { started = 0, skipped, succeeded, failed };
+    class script_compile_event : public event {
+    public:
+        script_compile_event(script_compile_status status, double time = 0.0) {
+            m_status = status;
+            m_time = time;
+        }
+
+        script_compile_status get_status() { return m_status; }
+
+        // seconds since the compile started
+        double get_time() { return m_time; }
+
+        EVENT_ID_DECL(script_compile)
+
+    private:
+        script_compile_status m_status;
+        double m_time;
+    };
+} // namespace sge
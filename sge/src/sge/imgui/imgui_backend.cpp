@@ -16,6 +16,8 @@
 
 #include "sgepch.h"
 #include "sge/imgui/imgui_backend.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_imgui_backend.h"
 #ifdef SGE_PLATFORM_DESKTOP
 #include "sge/platform/desktop/desktop_imgui_backend.h"
 #endif
@@ -27,6 +29,10 @@ namespace sge {
     std::unique_ptr<imgui_backend> imgui_backend::create_platform_backend() {
         imgui_backend* backend = nullptr;
 
+        if (renderer::get_backend() == renderer_backend::null) {
+            backend = new null_imgui_platform_backend;
+        }
+
 #ifdef SGE_PLATFORM_DESKTOP
         if (backend == nullptr) {
             backend = new desktop_imgui_backend;
@@ -39,6 +45,10 @@ namespace sge {
     std::unique_ptr<imgui_backend> imgui_backend::create_renderer_backend() {
         imgui_backend* backend = nullptr;
 
+        if (renderer::get_backend() == renderer_backend::null) {
+            backend = new null_imgui_renderer_backend;
+        }
+
 #ifdef SGE_USE_VULKAN
         if (backend == nullptr) {
             backend = new vulkan_imgui_backend;
@@ -0,0 +1,41 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/null/null_buffer.h"
+namespace sge {
+    null_vertex_buffer::null_vertex_buffer(const void* data, size_t stride, size_t count) {
+        m_stride = stride;
+        m_count = count;
+
+        auto bytes = (const uint8_t*)data;
+        m_data = std::vector<uint8_t>(bytes, bytes + stride * count);
+    }
+
+    null_vertex_buffer::null_vertex_buffer(size_t size) {
+        m_stride = 1;
+        m_count = size;
+        m_data.resize(size);
+    }
+
+    void null_uniform_buffer::set_data(const void* data, size_t size, size_t offset) {
+        if (offset + size > m_data.size()) {
+            throw std::runtime_error("attempted to write past the end of a uniform buffer!");
+        }
+
+        memcpy(m_data.data() + offset, data, size);
+    }
+} // namespace sge
@@ -0,0 +1,60 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/vertex_buffer.h"
+#include "sge/renderer/index_buffer.h"
+#include "sge/renderer/uniform_buffer.h"
+namespace sge {
+    // buffers keep their contents in host memory so that writes cost what they would on a gpu
+    class null_vertex_buffer : public vertex_buffer {
+    public:
+        null_vertex_buffer(const void* data, size_t stride, size_t count);
+        null_vertex_buffer(size_t size);
+
+        virtual size_t get_vertex_stride() override { return m_stride; }
+        virtual size_t get_vertex_count() override { return m_count; }
+
+        virtual void* get_mapped_data() override { return m_data.data(); }
+        virtual void flush(size_t offset, size_t size) override {}
+
+    private:
+        std::vector<uint8_t> m_data;
+        size_t m_stride, m_count;
+    };
+
+    class null_index_buffer : public index_buffer {
+    public:
+        null_index_buffer(const uint32_t* data, size_t count) : m_data(data, data + count) {}
+
+        virtual size_t get_index_count() override { return m_data.size(); }
+
+    private:
+        std::vector<uint32_t> m_data;
+    };
+
+    class null_uniform_buffer : public uniform_buffer {
+    public:
+        null_uniform_buffer(size_t size) : m_data(size) {}
+
+        virtual size_t get_size() override { return m_data.size(); }
+
+        virtual void set_data(const void* data, size_t size, size_t offset) override;
+
+    private:
+        std::vector<uint8_t> m_data;
+    };
+} // namespace sge
@@ -0,0 +1,40 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/command_queue.h"
+namespace sge {
+    class null_command_list : public command_list {
+    public:
+        virtual void reset() override {}
+        virtual void begin() override {}
+        virtual void end() override {}
+    };
+
+    class null_command_queue : public command_queue {
+    public:
+        null_command_queue(command_list_type type) : m_type(type) {}
+
+        virtual command_list& get() override { return m_cmdlist; }
+        virtual void submit(command_list& cmdlist, bool wait) override {}
+
+        virtual command_list_type get_type() override { return m_type; }
+
+    private:
+        command_list_type m_type;
+        null_command_list m_cmdlist;
+    };
+} // namespace sge
@@ -0,0 +1,66 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/null/null_framebuffer.h"
+#include "sge/platform/null/null_texture.h"
+namespace sge {
+    null_framebuffer::null_framebuffer(const framebuffer_spec& spec) {
+        m_spec = spec;
+        m_render_pass = ref<null_render_pass>::create(render_pass_parent_type::framebuffer);
+
+        create_attachments();
+    }
+
+    void null_framebuffer::resize(uint32_t new_width, uint32_t new_height) {
+        m_spec.width = new_width;
+        m_spec.height = new_height;
+
+        create_attachments();
+    }
+
+    size_t null_framebuffer::get_attachment_count(framebuffer_attachment_type type) {
+        auto it = m_attachments.find(type);
+        if (it == m_attachments.end()) {
+            return 0;
+        }
+
+        return it->second.size();
+    }
+
+    ref<image_2d> null_framebuffer::get_attachment(framebuffer_attachment_type type,
+                                                   size_t index) {
+        if (index >= get_attachment_count(type)) {
+            return nullptr;
+        }
+
+        return m_attachments[type][index];
+    }
+
+    void null_framebuffer::create_attachments() {
+        m_attachments.clear();
+
+        for (const auto& attachment : m_spec.attachments) {
+            image_spec spec;
+            spec.format = attachment.format;
+            spec.image_usage = image_usage_attachment | attachment.additional_usage;
+            spec.width = m_spec.width;
+            spec.height = m_spec.height;
+
+            m_attachments[attachment.type].push_back(ref<null_image_2d>::create(spec));
+        }
+    }
+} // namespace sge
@@ -0,0 +1,56 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/framebuffer.h"
+namespace sge {
+    class null_render_pass : public render_pass {
+    public:
+        null_render_pass(render_pass_parent_type parent_type) : m_parent_type(parent_type) {}
+
+        virtual render_pass_parent_type get_parent_type() override { return m_parent_type; }
+
+        virtual void begin(command_list& cmdlist, const glm::vec4& clear_color) override {}
+        virtual void end(command_list& cmdlist) override {}
+
+    private:
+        render_pass_parent_type m_parent_type;
+    };
+
+    class null_framebuffer : public framebuffer {
+    public:
+        null_framebuffer(const framebuffer_spec& spec);
+
+        virtual const framebuffer_spec& get_spec() override { return m_spec; }
+
+        virtual uint32_t get_width() override { return m_spec.width; }
+        virtual uint32_t get_height() override { return m_spec.height; }
+        virtual void resize(uint32_t new_width, uint32_t new_height) override;
+
+        virtual ref<render_pass> get_render_pass() override { return m_render_pass; }
+
+        virtual size_t get_attachment_count(framebuffer_attachment_type type) override;
+        virtual ref<image_2d> get_attachment(framebuffer_attachment_type type,
+                                             size_t index) override;
+
+    private:
+        void create_attachments();
+
+        framebuffer_spec m_spec;
+        ref<render_pass> m_render_pass;
+        std::map<framebuffer_attachment_type, std::vector<ref<image_2d>>> m_attachments;
+    };
+} // namespace sge
@@ -0,0 +1,45 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/null/null_imgui_backend.h"
+#include "sge/core/application.h"
+namespace sge {
+    null_imgui_platform_backend::null_imgui_platform_backend() {
+        // there are no platform windows to spawn viewports into
+        ImGuiIO& io = ImGui::GetIO();
+        io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+        io.BackendPlatformName = "sge_null";
+    }
+
+    void null_imgui_platform_backend::begin() {
+        auto _window = application::get().get_window();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2((float)_window->get_width(), (float)_window->get_height());
+        io.DeltaTime = 1.f / 60.f;
+    }
+
+    null_imgui_renderer_backend::null_imgui_renderer_backend() {
+        ImGuiIO& io = ImGui::GetIO();
+        io.BackendRendererName = "sge_null";
+
+        // imgui refuses to start a frame without a built font atlas
+        uint8_t* pixels;
+        int32_t width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    }
+} // namespace sge
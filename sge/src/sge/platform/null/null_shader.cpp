@@ -0,0 +1,57 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/null/null_shader.h"
+#include "sge/renderer/renderer.h"
+namespace sge {
+    // nothing is compiled, so report the size of the texture arrays in the builtin shaders
+    static constexpr uint32_t texture_capacity = 16;
+
+    null_shader::null_shader(const fs::path& path, shader_language language) {
+        m_path = path;
+        m_language = language;
+
+        // still validate the source
+        std::map<shader_stage, std::string> sources;
+        parse_source(m_path, sources);
+    }
+
+    bool null_shader::reload() {
+        if (!recompile()) {
+            return false;
+        }
+
+        apply_recompiled();
+        return true;
+    }
+
+    uint32_t null_shader::get_texture_capacity(uint32_t binding) { return texture_capacity; }
+
+    bool null_shader::recompile() {
+        try {
+            std::map<shader_stage, std::string> sources;
+            parse_source(m_path, sources);
+        } catch (const std::exception& exc) {
+            spdlog::error("failed to recompile shader {0}: {1}", m_path.string(), exc.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    void null_shader::apply_recompiled() { renderer::on_shader_reloaded(id); }
+} // namespace sge
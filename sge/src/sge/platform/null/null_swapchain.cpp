@@ -0,0 +1,47 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/null/null_swapchain.h"
+#include "sge/platform/null/null_framebuffer.h"
+namespace sge {
+    // same frames in flight as a typical double-buffered swapchain
+    static constexpr size_t image_count = 2;
+
+    null_swapchain::null_swapchain(ref<window> _window) {
+        m_width = _window->get_width();
+        m_height = _window->get_height();
+
+        m_render_pass = ref<null_render_pass>::create(render_pass_parent_type::swapchain);
+        m_command_lists.resize(image_count);
+        m_current_image = 0;
+    }
+
+    void null_swapchain::on_resize(uint32_t new_width, uint32_t new_height) {
+        m_width = new_width;
+        m_height = new_height;
+    }
+
+    void null_swapchain::new_frame() { m_current_image = (m_current_image + 1) % image_count; }
+
+    command_list& null_swapchain::get_command_list(size_t index) {
+        if (index >= m_command_lists.size()) {
+            throw std::runtime_error("invalid swapchain image index!");
+        }
+
+        return m_command_lists[index];
+    }
+} // namespace sge
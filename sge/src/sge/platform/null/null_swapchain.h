@@ -0,0 +1,46 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/swapchain.h"
+#include "sge/platform/null/null_command_queue.h"
+namespace sge {
+    class null_swapchain : public swapchain {
+    public:
+        null_swapchain(ref<window> _window);
+
+        virtual void on_resize(uint32_t new_width, uint32_t new_height) override;
+
+        virtual void new_frame() override;
+        virtual void present() override {}
+
+        virtual ref<render_pass> get_render_pass() override { return m_render_pass; }
+
+        virtual size_t get_image_count() override { return m_command_lists.size(); }
+        virtual uint32_t get_width() override { return m_width; }
+        virtual uint32_t get_height() override { return m_height; }
+
+        virtual size_t get_current_image_index() override { return m_current_image; }
+        virtual command_list& get_command_list(size_t index) override;
+
+    private:
+        ref<render_pass> m_render_pass;
+        std::vector<null_command_list> m_command_lists;
+
+        uint32_t m_width, m_height;
+        size_t m_current_image;
+    };
+} // namespace sge
@@ -0,0 +1,40 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/null/null_texture.h"
+namespace sge {
+    void null_image_2d::copy_from(const void* data, size_t size) {
+        auto bytes = (const uint8_t*)data;
+        m_data = std::vector<uint8_t>(bytes, bytes + size);
+    }
+
+    bool null_image_2d::copy_to(void* data, size_t size) {
+        if (size > m_data.size()) {
+            return false;
+        }
+
+        memcpy(data, m_data.data(), size);
+        return true;
+    }
+
+    null_texture_2d::null_texture_2d(const texture_spec& spec) {
+        m_image = spec.image;
+        m_wrap = spec.wrap;
+        m_filter = spec.filter;
+        m_path = spec.path;
+    }
+} // namespace sge
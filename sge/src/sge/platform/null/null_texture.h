@@ -0,0 +1,61 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/renderer/texture.h"
+namespace sge {
+    class null_image_2d : public image_2d {
+    public:
+        null_image_2d(const image_spec& spec) : m_spec(spec) {}
+
+        virtual uint32_t get_width() override { return m_spec.width; }
+        virtual uint32_t get_height() override { return m_spec.height; }
+
+        virtual uint32_t get_mip_level_count() override { return m_spec.mip_levels; }
+        virtual uint32_t get_array_layer_count() override { return m_spec.array_layers; }
+
+        virtual image_format get_format() override { return m_spec.format; }
+        virtual uint32_t get_usage() override { return m_spec.image_usage; }
+
+    protected:
+        virtual void copy_from(const void* data, size_t size) override;
+        virtual bool copy_to(void* data, size_t size) override;
+
+    private:
+        image_spec m_spec;
+        std::vector<uint8_t> m_data;
+    };
+
+    class null_texture_2d : public texture_2d {
+    public:
+        null_texture_2d(const texture_spec& spec);
+
+        virtual bool reload() override { return false; }
+
+        virtual ref<image_2d> get_image() override { return m_image; }
+        virtual texture_wrap get_wrap() override { return m_wrap; }
+        virtual texture_filter get_filter() override { return m_filter; }
+        virtual const fs::path& get_path() override { return m_path; }
+
+        virtual ImTextureID get_imgui_id() override { return (ImTextureID)nullptr; }
+
+    private:
+        ref<image_2d> m_image;
+        texture_wrap m_wrap;
+        texture_filter m_filter;
+        fs::path m_path;
+    };
+} // namespace sge
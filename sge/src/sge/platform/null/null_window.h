@@ -0,0 +1,50 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/core/window.h"
+namespace sge {
+    // a window that never appears on screen, for headless runs
+    class null_window : public window {
+    public:
+        null_window(const std::string& title, uint32_t width, uint32_t height)
+            : m_title(title), m_width(width), m_height(height) {}
+
+        virtual void on_update() override {}
+
+        virtual uint32_t get_width() override { return m_width; }
+        virtual uint32_t get_height() override { return m_height; }
+
+        virtual void set_title(const std::string& title) override { m_title = title; }
+        virtual void set_event_callback(event_callback_t callback) override {
+            m_event_callback = callback;
+        }
+
+        virtual void* get_native_window() override { return nullptr; }
+        virtual void* create_render_surface(void* params) override { return nullptr; }
+        virtual void get_vulkan_extensions(std::set<std::string>& extensions) override {}
+
+        virtual std::optional<fs::path> file_dialog(
+            dialog_mode mode, const std::vector<dialog_file_filter>& filters) override {
+            return std::optional<fs::path>();
+        }
+
+    private:
+        std::string m_title;
+        uint32_t m_width, m_height;
+        event_callback_t m_event_callback;
+    };
+} // namespace sge
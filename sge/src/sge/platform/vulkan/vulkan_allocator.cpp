@@ -87,4 +87,9 @@ namespace sge {
     void vulkan_allocator::unmap(VmaAllocation allocation) {
         vmaUnmapMemory(vk_allocator, allocation);
     }
+
+    void vulkan_allocator::flush(VmaAllocation allocation, size_t offset, size_t size) {
+        VkResult result = vmaFlushAllocation(vk_allocator, allocation, offset, size);
+        check_vk_result(result);
+    }
 } // namespace sge
\ No newline at end of file
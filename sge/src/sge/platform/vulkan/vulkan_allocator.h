@@ -38,5 +38,6 @@ namespace sge {
         // mapping memory
         static void* map(VmaAllocation allocation);
         static void unmap(VmaAllocation allocation);
+        static void flush(VmaAllocation allocation, size_t offset, size_t size);
     };
 } // namespace sge
\ No newline at end of file
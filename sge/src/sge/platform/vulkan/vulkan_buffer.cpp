@@ -31,7 +31,10 @@ namespace sge {
         create();
     }
 
-    vulkan_buffer::~vulkan_buffer() { vulkan_allocator::free(m_buffer, m_allocation); }
+    vulkan_buffer::~vulkan_buffer() {
+        unmap();
+        vulkan_allocator::free(m_buffer, m_allocation);
+    }
 
     void vulkan_buffer::map() {
         if (mapped != nullptr) {
@@ -50,6 +53,14 @@ namespace sge {
         mapped = nullptr;
     }
 
+    void vulkan_buffer::flush(size_t offset, size_t size) {
+        if (offset + size > m_size) {
+            throw std::runtime_error("cannot flush outside buffer memory!");
+        }
+
+        vulkan_allocator::flush(m_allocation, offset, size);
+    }
+
     void vulkan_buffer::copy_to(ref<vulkan_buffer> dest, const VkBufferCopy& region) {
         auto queue = renderer::get_queue(command_list_type::transfer);
         auto& cmdlist = (vulkan_command_list&)queue->get();
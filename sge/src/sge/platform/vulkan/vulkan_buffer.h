@@ -27,6 +27,7 @@ namespace sge {
         void* mapped = nullptr;
         void map();
         void unmap();
+        void flush(size_t offset, size_t size);
 
         void copy_to(ref<vulkan_buffer> dest, const VkBufferCopy& region);
 
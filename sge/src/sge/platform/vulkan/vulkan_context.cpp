@@ -19,6 +19,7 @@
 #include "sge/platform/vulkan/vulkan_context.h"
 #include "sge/core/application.h"
 #include "sge/platform/vulkan/vulkan_allocator.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
 namespace sge {
     static std::unique_ptr<vulkan_context> vk_context_instance;
 
@@ -278,9 +279,11 @@ namespace sge {
         }
 
         vulkan_allocator::init();
+        vulkan_pipeline_cache::init();
     }
 
     void vulkan_context::shutdown() {
+        vulkan_pipeline_cache::shutdown();
         vulkan_allocator::shutdown();
 
         m_data->device.reset();
@@ -20,33 +20,13 @@
 #include "sge/platform/vulkan/vulkan_context.h"
 #include "sge/platform/vulkan/vulkan_shader.h"
 #include "sge/platform/vulkan/vulkan_render_pass.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
 #include "sge/core/application.h"
 #include "sge/renderer/renderer.h"
 namespace sge {
     vulkan_pipeline::vulkan_pipeline(const pipeline_spec& spec) {
         m_spec = spec;
-
-        {
-            static const std::vector<VkDescriptorPoolSize> pool_sizes = {
-                { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10 },
-                { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 10 },
-                { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1000 },
-                { VK_DESCRIPTOR_TYPE_SAMPLER, 1000 },
-                { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000 }
-            };
-
-            auto create_info =
-                vk_init<VkDescriptorPoolCreateInfo>(VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO);
-            create_info.maxSets = 10;
-            create_info.poolSizeCount = pool_sizes.size();
-            create_info.pPoolSizes = pool_sizes.data();
-            create_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-
-            VkDevice device = vulkan_context::get().get_device().get();
-            VkResult result = vkCreateDescriptorPool(device, &create_info, nullptr,
-                                                     &m_descriptor_sets.pool);
-            check_vk_result(result);
-        }
+        create_descriptor_pool();
 
         if (!m_spec._shader) {
             throw std::runtime_error("no shader was provided!");
@@ -87,7 +67,22 @@ namespace sge {
     }
 
     void vulkan_pipeline::invalidate() {
-        destroy();
+        // frames in flight may still be using the old pipeline and descriptor sets, so the old
+        // pool is retired as a whole instead of freeing its sets here
+        {
+            ref<vulkan_pipeline_state> state = m_state;
+            VkDescriptorPool pool = m_descriptor_sets.pool;
+
+            renderer::retire([state, pool]() {
+                VkDevice device = vulkan_context::get().get_device().get();
+                vkDestroyDescriptorPool(device, pool, nullptr);
+            });
+
+            m_state.reset();
+            m_descriptor_sets.sets.clear();
+        }
+
+        create_descriptor_pool();
         create();
 
         {
@@ -176,30 +171,98 @@ namespace sge {
 
     void vulkan_pipeline::get_descriptor_sets(
         std::map<uint32_t, std::vector<VkDescriptorSet>>& sets) {
-        sets.clear();
+        sets = m_descriptor_sets.sets;
+    }
 
-        for (const auto& [set, data] : m_descriptor_sets.sets) {
-            sets.insert(std::make_pair(set, data.sets));
-        }
+    void vulkan_pipeline::create_descriptor_pool() {
+        static const std::vector<VkDescriptorPoolSize> pool_sizes = {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 10 },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 10 },
+            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1000 },
+            { VK_DESCRIPTOR_TYPE_SAMPLER, 1000 },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000 }
+        };
+
+        auto create_info =
+            vk_init<VkDescriptorPoolCreateInfo>(VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO);
+        create_info.maxSets = 10;
+        create_info.poolSizeCount = pool_sizes.size();
+        create_info.pPoolSizes = pool_sizes.data();
+        create_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+
+        VkDevice device = vulkan_context::get().get_device().get();
+        VkResult result =
+            vkCreateDescriptorPool(device, &create_info, nullptr, &m_descriptor_sets.pool);
+        check_vk_result(result);
     }
 
     void vulkan_pipeline::create() {
-        create_descriptor_sets();
-        create_pipeline();
+        vulkan_pipeline_key key = get_key();
+
+        m_state = vulkan_pipeline_cache::find(key);
+        if (!m_state) {
+            m_state = ref<vulkan_pipeline_state>::create();
+
+            create_set_layouts();
+            create_pipeline();
+
+            vulkan_pipeline_cache::add(key, m_state);
+        }
+
+        alloc_descriptor_sets();
     }
 
     void vulkan_pipeline::destroy() {
         VkDevice device = vulkan_context::get().get_device().get();
 
-        vkDestroyPipeline(device, m_pipeline, nullptr);
-        vkDestroyPipelineLayout(device, m_layout, nullptr);
-
-        for (const auto& [index, set] : m_descriptor_sets.sets) {
-            vkFreeDescriptorSets(device, m_descriptor_sets.pool, set.sets.size(),
-                                 set.sets.data());
-            vkDestroyDescriptorSetLayout(device, set.layout, nullptr);
+        for (const auto& [index, sets] : m_descriptor_sets.sets) {
+            vkFreeDescriptorSets(device, m_descriptor_sets.pool, sets.size(), sets.data());
         }
         m_descriptor_sets.sets.clear();
+
+        m_state.reset();
+    }
+
+    static void hash_combine(size_t& seed, size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    vulkan_pipeline_key vulkan_pipeline::get_key() {
+        if (!m_spec.renderpass) {
+            throw std::runtime_error("no render pass was provided!");
+        }
+
+        vulkan_pipeline_key key;
+        key.shader = m_spec._shader->id;
+        key.renderpass = m_spec.renderpass.as<vulkan_render_pass>().raw();
+
+        const auto& input_layout = m_spec.input_layout;
+        key.input_layout = input_layout;
+
+        key.input_layout_hash = input_layout.stride;
+        hash_combine(key.input_layout_hash, (size_t)input_layout.input_rate);
+        for (const auto& attribute : input_layout.attributes) {
+            hash_combine(key.input_layout_hash, (size_t)attribute.type);
+            hash_combine(key.input_layout_hash, attribute.offset);
+        }
+
+        key.wireframe = m_spec.wireframe;
+        key.enable_culling = m_spec.enable_culling;
+        key.state_hash = (key.wireframe ? 1 : 0) | (key.enable_culling ? 2 : 0);
+
+        get_blend_attachment_states(key.blend_attachments);
+        for (const auto& state : key.blend_attachments) {
+            hash_combine(key.state_hash, state.blendEnable);
+            hash_combine(key.state_hash, state.srcColorBlendFactor);
+            hash_combine(key.state_hash, state.dstColorBlendFactor);
+            hash_combine(key.state_hash, state.colorBlendOp);
+            hash_combine(key.state_hash, state.srcAlphaBlendFactor);
+            hash_combine(key.state_hash, state.dstAlphaBlendFactor);
+            hash_combine(key.state_hash, state.alphaBlendOp);
+            hash_combine(key.state_hash, state.colorWriteMask);
+        }
+
+        return key;
     }
 
     struct set_binding_data {
@@ -207,7 +270,7 @@ namespace sge {
         std::vector<VkDescriptorSetLayoutBinding> bindings;
     };
 
-    void vulkan_pipeline::create_descriptor_sets() {
+    void vulkan_pipeline::create_set_layouts() {
         auto vk_shader = m_spec._shader.as<vulkan_shader>();
         const auto& reflection_data = vk_shader->get_reflection_data();
 
@@ -286,116 +349,69 @@ namespace sge {
         }
 
         VkDevice device = vulkan_context::get().get_device().get();
-        swapchain& swap_chain = application::get().get_swapchain();
-        size_t image_count = swap_chain.get_image_count();
         for (const auto& [set, set_bindings] : bindings) {
-            descriptor_set_t set_data;
+            VkDescriptorSetLayout set_layout;
 
             auto layout_info = vk_init<VkDescriptorSetLayoutCreateInfo>(
                 VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO);
             layout_info.bindingCount = set_bindings.bindings.size();
             layout_info.pBindings = set_bindings.bindings.data();
             VkResult result =
-                vkCreateDescriptorSetLayout(device, &layout_info, nullptr, &set_data.layout);
+                vkCreateDescriptorSetLayout(device, &layout_info, nullptr, &set_layout);
             check_vk_result(result);
 
-            std::vector<VkDescriptorSetLayout> layouts(image_count, set_data.layout);
-            set_data.sets.resize(image_count);
+            m_state->set_layouts.insert(std::make_pair(set, set_layout));
+        }
+    }
+
+    void vulkan_pipeline::alloc_descriptor_sets() {
+        VkDevice device = vulkan_context::get().get_device().get();
+        swapchain& swap_chain = application::get().get_swapchain();
+        size_t image_count = swap_chain.get_image_count();
+
+        for (const auto& [set, set_layout] : m_state->set_layouts) {
+            std::vector<VkDescriptorSetLayout> layouts(image_count, set_layout);
+            std::vector<VkDescriptorSet> sets(image_count);
 
             auto alloc_info = vk_init<VkDescriptorSetAllocateInfo>(
                 VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO);
             alloc_info.descriptorPool = m_descriptor_sets.pool;
             alloc_info.descriptorSetCount = image_count;
             alloc_info.pSetLayouts = layouts.data();
-            result = vkAllocateDescriptorSets(device, &alloc_info, set_data.sets.data());
+            VkResult result = vkAllocateDescriptorSets(device, &alloc_info, sets.data());
             check_vk_result(result);
 
-            m_descriptor_sets.sets.insert(std::make_pair(set, set_data));
+            m_descriptor_sets.sets.insert(std::make_pair(set, sets));
         }
     }
 
-    void vulkan_pipeline::create_pipeline() {
-        VkDevice device = vulkan_context::get().get_device().get();
-        auto vk_shader = m_spec._shader.as<vulkan_shader>();
-
-        if (!m_spec.renderpass) {
-            throw std::runtime_error("no render pass was provided!");
-        }
-        auto vk_render_pass = m_spec.renderpass.as<vulkan_render_pass>();
-
-        const auto& push_constant_range = vk_shader->get_reflection_data().push_constant_buffer;
-        VkPushConstantRange range;
-        range.offset = 0;
-        range.size = push_constant_range.size;
-        range.stageFlags = push_constant_range.stage;
-
-        auto layout_info =
-            vk_init<VkPipelineLayoutCreateInfo>(VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO);
-
-        if (range.size > 0) {
-            layout_info.pushConstantRangeCount = 1;
-            layout_info.pPushConstantRanges = &range;
-        }
-
-        std::vector<VkDescriptorSetLayout> set_layouts;
-        for (const auto& [set, data] : m_descriptor_sets.sets) {
-            for (size_t i = 0; i < (size_t)set - set_layouts.size(); i++) {
-                set_layouts.push_back(nullptr);
-            }
-            set_layouts.push_back(data.layout);
-        }
-        if (!set_layouts.empty()) {
-            layout_info.setLayoutCount = set_layouts.size();
-            layout_info.pSetLayouts = set_layouts.data();
-        }
-
-        VkResult result = vkCreatePipelineLayout(device, &layout_info, nullptr, &m_layout);
-        check_vk_result(result);
-
-        auto pipeline_info =
-            vk_init<VkGraphicsPipelineCreateInfo>(VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO);
-        pipeline_info.layout = m_layout;
-        pipeline_info.renderPass = vk_render_pass->get();
+    void vulkan_pipeline::get_blend_attachment_states(
+        std::vector<VkPipelineColorBlendAttachmentState>& states) {
+        states.clear();
 
-        auto input_assembly = vk_init<VkPipelineInputAssemblyStateCreateInfo>(
-            VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO);
-        input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-        auto rasterizer = vk_init<VkPipelineRasterizationStateCreateInfo>(
-            VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO);
-        rasterizer.polygonMode =
-            (m_spec.wireframe ? VK_POLYGON_MODE_LINE : VK_POLYGON_MODE_FILL);
-        rasterizer.cullMode =
-            (m_spec.enable_culling ? VK_CULL_MODE_BACK_BIT : VK_CULL_MODE_NONE);
-        rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
-        rasterizer.depthClampEnable = false;
-        rasterizer.rasterizerDiscardEnable = false;
-        rasterizer.depthBiasEnable = false;
-        rasterizer.lineWidth = 1.f;
-
-        std::vector<VkPipelineColorBlendAttachmentState> blend_attachment_states;
         switch (m_spec.renderpass->get_parent_type()) {
         case render_pass_parent_type::swapchain:
-            blend_attachment_states.resize(1);
-            blend_attachment_states[0] = vk_init<VkPipelineColorBlendAttachmentState>();
-            blend_attachment_states[0].colorWriteMask = 0xf;
-            blend_attachment_states[0].blendEnable = true;
-            blend_attachment_states[0].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-            blend_attachment_states[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-            blend_attachment_states[0].colorBlendOp = VK_BLEND_OP_ADD;
-            blend_attachment_states[0].alphaBlendOp = VK_BLEND_OP_ADD;
-            blend_attachment_states[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-            blend_attachment_states[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+            states.resize(1);
+            states[0] = vk_init<VkPipelineColorBlendAttachmentState>();
+            states[0].colorWriteMask = 0xf;
+            states[0].blendEnable = true;
+            states[0].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+            states[0].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            states[0].colorBlendOp = VK_BLEND_OP_ADD;
+            states[0].alphaBlendOp = VK_BLEND_OP_ADD;
+            states[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            states[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
             break;
         case render_pass_parent_type::framebuffer: {
+            auto vk_render_pass = m_spec.renderpass.as<vulkan_render_pass>();
             auto fb = vk_render_pass->get_framebuffer_parent();
             const auto& spec = fb->get_spec();
 
             size_t attachment_count = fb->get_attachment_count(framebuffer_attachment_type::color);
-            blend_attachment_states.resize(attachment_count);
+            states.resize(attachment_count);
 
             for (size_t i = 0; i < attachment_count; i++) {
-                auto& blend_attachment_state = blend_attachment_states[i];
+                auto& blend_attachment_state = states[i];
                 blend_attachment_state = vk_init<VkPipelineColorBlendAttachmentState>();
                 blend_attachment_state.colorWriteMask = 0xf;
 
@@ -442,6 +458,66 @@ namespace sge {
         default:
             throw std::runtime_error("this shouldn't be reached");
         }
+    }
+
+    void vulkan_pipeline::create_pipeline() {
+        VkDevice device = vulkan_context::get().get_device().get();
+        auto vk_shader = m_spec._shader.as<vulkan_shader>();
+        auto vk_render_pass = m_spec.renderpass.as<vulkan_render_pass>();
+
+        const auto& push_constant_range = vk_shader->get_reflection_data().push_constant_buffer;
+        VkPushConstantRange range;
+        range.offset = 0;
+        range.size = push_constant_range.size;
+        range.stageFlags = push_constant_range.stage;
+
+        auto layout_info =
+            vk_init<VkPipelineLayoutCreateInfo>(VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO);
+
+        if (range.size > 0) {
+            layout_info.pushConstantRangeCount = 1;
+            layout_info.pPushConstantRanges = &range;
+        }
+
+        std::vector<VkDescriptorSetLayout> set_layouts;
+        for (const auto& [set, set_layout] : m_state->set_layouts) {
+            for (size_t i = 0; i < (size_t)set - set_layouts.size(); i++) {
+                set_layouts.push_back(nullptr);
+            }
+            set_layouts.push_back(set_layout);
+        }
+        if (!set_layouts.empty()) {
+            layout_info.setLayoutCount = set_layouts.size();
+            layout_info.pSetLayouts = set_layouts.data();
+        }
+
+        VkResult result =
+            vkCreatePipelineLayout(device, &layout_info, nullptr, &m_state->layout);
+        check_vk_result(result);
+
+        auto pipeline_info =
+            vk_init<VkGraphicsPipelineCreateInfo>(VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO);
+        pipeline_info.layout = m_state->layout;
+        pipeline_info.renderPass = vk_render_pass->get();
+
+        auto input_assembly = vk_init<VkPipelineInputAssemblyStateCreateInfo>(
+            VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO);
+        input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        auto rasterizer = vk_init<VkPipelineRasterizationStateCreateInfo>(
+            VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO);
+        rasterizer.polygonMode =
+            (m_spec.wireframe ? VK_POLYGON_MODE_LINE : VK_POLYGON_MODE_FILL);
+        rasterizer.cullMode =
+            (m_spec.enable_culling ? VK_CULL_MODE_BACK_BIT : VK_CULL_MODE_NONE);
+        rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+        rasterizer.depthClampEnable = false;
+        rasterizer.rasterizerDiscardEnable = false;
+        rasterizer.depthBiasEnable = false;
+        rasterizer.lineWidth = 1.f;
+
+        std::vector<VkPipelineColorBlendAttachmentState> blend_attachment_states;
+        get_blend_attachment_states(blend_attachment_states);
 
         auto color_blend_state = vk_init<VkPipelineColorBlendStateCreateInfo>(
             VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO);
@@ -472,7 +548,16 @@ namespace sge {
 
         VkVertexInputBindingDescription input_binding;
         input_binding.binding = 0;
-        input_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        switch (input_layout.input_rate) {
+        case vertex_input_rate::vertex:
+            input_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+            break;
+        case vertex_input_rate::instance:
+            input_binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+            break;
+        default:
+            throw std::runtime_error("invalid input rate!");
+        }
         input_binding.stride = input_layout.stride;
 
         std::vector<VkVertexInputAttributeDescription> attributes;
@@ -556,8 +641,8 @@ namespace sge {
         pipeline_info.pDepthStencilState = nullptr;
         pipeline_info.pDynamicState = &dynamic_state;
 
-        result = vkCreateGraphicsPipelines(device, nullptr, 1, &pipeline_info, nullptr,
-                                           &m_pipeline);
+        result = vkCreateGraphicsPipelines(device, vulkan_pipeline_cache::get(), 1, &pipeline_info,
+                                           nullptr, &m_state->pipeline);
         check_vk_result(result);
     }
 
@@ -571,7 +656,7 @@ namespace sge {
                                      " does not exist!");
         }
 
-        for (VkDescriptorSet desc_set : m_descriptor_sets.sets[written_set].sets) {
+        for (VkDescriptorSet desc_set : m_descriptor_sets.sets[written_set]) {
             auto write = vk_init<VkWriteDescriptorSet>(VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET);
 
             write.pBufferInfo = &ubo->get_descriptor_info();
@@ -592,7 +677,7 @@ namespace sge {
                                      " does not exist!");
         }
 
-        for (VkDescriptorSet desc_set : m_descriptor_sets.sets[written_set].sets) {
+        for (VkDescriptorSet desc_set : m_descriptor_sets.sets[written_set]) {
             auto write = vk_init<VkWriteDescriptorSet>(VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET);
 
             write.pImageInfo = &tex->get_descriptor_info();
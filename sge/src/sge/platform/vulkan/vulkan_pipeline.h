@@ -18,6 +18,7 @@
 #include "sge/renderer/pipeline.h"
 #include "sge/platform/vulkan/vulkan_uniform_buffer.h"
 #include "sge/platform/vulkan/vulkan_texture.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
 namespace sge {
     class vulkan_pipeline : public pipeline {
     public:
@@ -32,19 +33,14 @@ namespace sge {
         virtual void set_uniform_buffer(ref<uniform_buffer> ubo, uint32_t binding) override;
         virtual void set_texture(ref<texture_2d> tex, uint32_t binding, uint32_t slot) override;
 
-        VkPipeline get_pipeline() { return m_pipeline; }
-        VkPipelineLayout get_pipeline_layout() { return m_layout; }
+        VkPipeline get_pipeline() { return m_state->pipeline; }
+        VkPipelineLayout get_pipeline_layout() { return m_state->layout; }
         void get_descriptor_sets(std::map<uint32_t, std::vector<VkDescriptorSet>>& sets);
 
     private:
-        struct descriptor_set_t {
-            VkDescriptorSetLayout layout;
-            std::vector<VkDescriptorSet> sets;
-        };
-
         struct descriptor_sets_t {
             VkDescriptorPool pool;
-            std::map<uint32_t, descriptor_set_t> sets;
+            std::map<uint32_t, std::vector<VkDescriptorSet>> sets;
         };
 
         struct descriptor_set_binding_t {
@@ -52,19 +48,24 @@ namespace sge {
             std::vector<ref<vulkan_texture_2d>> textures;
         };
 
+        void create_descriptor_pool();
         void create();
         void destroy();
 
-        void create_descriptor_sets();
+        vulkan_pipeline_key get_key();
+        void get_blend_attachment_states(std::vector<VkPipelineColorBlendAttachmentState>& states);
+
+        void create_set_layouts();
         void create_pipeline();
+        void alloc_descriptor_sets();
 
         void write(ref<vulkan_uniform_buffer> ubo, uint32_t binding,
                    std::vector<VkWriteDescriptorSet>& writes);
         void write(ref<vulkan_texture_2d> tex, uint32_t binding, uint32_t slot,
                    std::vector<VkWriteDescriptorSet>& writes);
 
-        VkPipeline m_pipeline;
-        VkPipelineLayout m_layout;
+        // shared with every other pipeline with the same key
+        ref<vulkan_pipeline_state> m_state;
 
         pipeline_spec m_spec;
         descriptor_sets_t m_descriptor_sets;
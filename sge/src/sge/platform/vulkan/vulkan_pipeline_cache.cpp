@@ -0,0 +1,260 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/platform/vulkan/vulkan_base.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
+#include "sge/platform/vulkan/vulkan_context.h"
+namespace sge {
+    struct pipeline_cache_data_t {
+        VkPipelineCache cache = nullptr;
+        std::unordered_map<vulkan_pipeline_key, ref<vulkan_pipeline_state>> states;
+    };
+
+    static std::unique_ptr<pipeline_cache_data_t> s_cache_data;
+
+    static bool blend_attachments_equal(const VkPipelineColorBlendAttachmentState& lhs,
+                                        const VkPipelineColorBlendAttachmentState& rhs) {
+        return lhs.blendEnable == rhs.blendEnable &&
+               lhs.srcColorBlendFactor == rhs.srcColorBlendFactor &&
+               lhs.dstColorBlendFactor == rhs.dstColorBlendFactor &&
+               lhs.colorBlendOp == rhs.colorBlendOp &&
+               lhs.srcAlphaBlendFactor == rhs.srcAlphaBlendFactor &&
+               lhs.dstAlphaBlendFactor == rhs.dstAlphaBlendFactor &&
+               lhs.alphaBlendOp == rhs.alphaBlendOp && lhs.colorWriteMask == rhs.colorWriteMask;
+    }
+
+    // the hashes only narrow the search; a collision must not hand out a pipeline built for a
+    // different vertex layout or blend state
+    bool vulkan_pipeline_key::operator==(const vulkan_pipeline_key& other) const {
+        if (shader != other.shader || renderpass != other.renderpass ||
+            input_layout_hash != other.input_layout_hash || state_hash != other.state_hash) {
+            return false;
+        }
+
+        if (input_layout.stride != other.input_layout.stride ||
+            input_layout.input_rate != other.input_layout.input_rate ||
+            input_layout.attributes.size() != other.input_layout.attributes.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < input_layout.attributes.size(); i++) {
+            const auto& attribute = input_layout.attributes[i];
+            const auto& other_attribute = other.input_layout.attributes[i];
+
+            if (attribute.type != other_attribute.type ||
+                attribute.offset != other_attribute.offset) {
+                return false;
+            }
+        }
+
+        if (wireframe != other.wireframe || enable_culling != other.enable_culling ||
+            blend_attachments.size() != other.blend_attachments.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < blend_attachments.size(); i++) {
+            if (!blend_attachments_equal(blend_attachments[i], other.blend_attachments[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    vulkan_pipeline_state::~vulkan_pipeline_state() {
+        VkDevice device = vulkan_context::get().get_device().get();
+
+        vkDestroyPipeline(device, pipeline, nullptr);
+        vkDestroyPipelineLayout(device, layout, nullptr);
+
+        for (const auto& [set, set_layout] : set_layouts) {
+            vkDestroyDescriptorSetLayout(device, set_layout, nullptr);
+        }
+    }
+
+    static VkPipelineCache create_cache(const void* data, size_t size) {
+        auto create_info =
+            vk_init<VkPipelineCacheCreateInfo>(VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+        create_info.initialDataSize = size;
+        create_info.pInitialData = data;
+
+        VkPipelineCache cache;
+        VkDevice device = vulkan_context::get().get_device().get();
+        VkResult result = vkCreatePipelineCache(device, &create_info, nullptr, &cache);
+        check_vk_result(result);
+
+        return cache;
+    }
+
+    void vulkan_pipeline_cache::init() {
+        if (s_cache_data) {
+            return;
+        }
+
+        s_cache_data = std::make_unique<pipeline_cache_data_t>();
+        s_cache_data->cache = create_cache(nullptr, 0);
+    }
+
+    void vulkan_pipeline_cache::shutdown() {
+        if (!s_cache_data) {
+            return;
+        }
+
+        s_cache_data->states.clear();
+
+        VkDevice device = vulkan_context::get().get_device().get();
+        vkDestroyPipelineCache(device, s_cache_data->cache, nullptr);
+
+        s_cache_data.reset();
+    }
+
+    VkPipelineCache vulkan_pipeline_cache::get() {
+        return s_cache_data ? s_cache_data->cache : nullptr;
+    }
+
+    // drivers are supposed to reject foreign cache data, but not all of them do
+    static bool is_cache_compatible(const std::vector<uint8_t>& data) {
+        struct cache_header_t {
+            uint32_t length, version, vendor_id, device_id;
+            uint8_t uuid[VK_UUID_SIZE];
+        };
+
+        if (data.size() < sizeof(cache_header_t)) {
+            return false;
+        }
+
+        cache_header_t header;
+        memcpy(&header, data.data(), sizeof(cache_header_t));
+
+        VkPhysicalDeviceProperties properties;
+        vulkan_context::get().get_device().get_physical_device().get_properties(properties);
+
+        return header.version == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               header.vendor_id == properties.vendorID &&
+               header.device_id == properties.deviceID &&
+               memcmp(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    bool vulkan_pipeline_cache::load(const fs::path& path) {
+        if (!s_cache_data || !fs::exists(path)) {
+            return false;
+        }
+
+        std::vector<uint8_t> data;
+        {
+            std::ifstream stream(path, std::ios::in | std::ios::binary);
+            stream.seekg(0, std::ios::end);
+            data.resize((size_t)stream.tellg());
+            stream.seekg(0, std::ios::beg);
+            stream.read((char*)data.data(), data.size());
+            stream.close();
+        }
+
+        if (!is_cache_compatible(data)) {
+            spdlog::info("discarding incompatible pipeline cache: {0}", path.string());
+            return false;
+        }
+
+        VkDevice device = vulkan_context::get().get_device().get();
+        VkPipelineCache loaded_cache = create_cache(data.data(), data.size());
+
+        VkResult result =
+            vkMergePipelineCaches(device, s_cache_data->cache, 1, &loaded_cache);
+        vkDestroyPipelineCache(device, loaded_cache, nullptr);
+        check_vk_result(result);
+
+        return true;
+    }
+
+    bool vulkan_pipeline_cache::save(const fs::path& path) {
+        if (!s_cache_data) {
+            return false;
+        }
+
+        VkDevice device = vulkan_context::get().get_device().get();
+        size_t size = 0;
+        VkResult result = vkGetPipelineCacheData(device, s_cache_data->cache, &size, nullptr);
+        check_vk_result(result);
+
+        std::vector<uint8_t> data(size);
+        result = vkGetPipelineCacheData(device, s_cache_data->cache, &size, data.data());
+        check_vk_result(result);
+
+        fs::path directory = path.parent_path();
+        if (!directory.empty() && !fs::exists(directory)) {
+            fs::create_directories(directory);
+        }
+
+        std::ofstream stream(path, std::ios::out | std::ios::binary);
+        stream.write((const char*)data.data(), size);
+        stream.close();
+
+        return true;
+    }
+
+    ref<vulkan_pipeline_state> vulkan_pipeline_cache::find(const vulkan_pipeline_key& key) {
+        if (!s_cache_data) {
+            return nullptr;
+        }
+
+        auto it = s_cache_data->states.find(key);
+        if (it == s_cache_data->states.end()) {
+            return nullptr;
+        }
+
+        return it->second;
+    }
+
+    void vulkan_pipeline_cache::add(const vulkan_pipeline_key& key,
+                                    ref<vulkan_pipeline_state> state) {
+        if (!s_cache_data) {
+            return;
+        }
+
+        s_cache_data->states[key] = state;
+    }
+
+    void vulkan_pipeline_cache::evict(guid shader) {
+        if (!s_cache_data) {
+            return;
+        }
+
+        auto& states = s_cache_data->states;
+        for (auto it = states.begin(); it != states.end();) {
+            if (it->first.shader == shader) {
+                it = states.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    void vulkan_pipeline_cache::evict(vulkan_render_pass* renderpass) {
+        if (!s_cache_data) {
+            return;
+        }
+
+        auto& states = s_cache_data->states;
+        for (auto it = states.begin(); it != states.end();) {
+            if (it->first.renderpass == renderpass) {
+                it = states.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+} // namespace sge
@@ -0,0 +1,81 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#include "sge/core/guid.h"
+#include "sge/renderer/pipeline.h"
+namespace sge {
+    class vulkan_render_pass;
+
+    // pipeline objects shared between every vulkan_pipeline with the same key
+    struct vulkan_pipeline_state : public ref_counted {
+        ~vulkan_pipeline_state();
+
+        VkPipeline pipeline = nullptr;
+        VkPipelineLayout layout = nullptr;
+        std::map<uint32_t, VkDescriptorSetLayout> set_layouts;
+    };
+
+    struct vulkan_pipeline_key {
+        guid shader;
+        vulkan_render_pass* renderpass;
+
+        pipeline_input_layout input_layout;
+        bool wireframe;
+        bool enable_culling;
+        std::vector<VkPipelineColorBlendAttachmentState> blend_attachments;
+
+        // hashes of the vertex input layout and the blend/rasterizer state, for std::hash
+        size_t input_layout_hash;
+        size_t state_hash;
+
+        bool operator==(const vulkan_pipeline_key& other) const;
+    };
+
+    class vulkan_pipeline_cache {
+    public:
+        static void init();
+        static void shutdown();
+
+        vulkan_pipeline_cache() = delete;
+
+        static VkPipelineCache get();
+
+        // merges/serializes driver pipeline cache data
+        static bool load(const fs::path& path);
+        static bool save(const fs::path& path);
+
+        static ref<vulkan_pipeline_state> find(const vulkan_pipeline_key& key);
+        static void add(const vulkan_pipeline_key& key, ref<vulkan_pipeline_state> state);
+
+        static void evict(guid shader);
+        static void evict(vulkan_render_pass* renderpass);
+    };
+} // namespace sge
+
+namespace std {
+    template <>
+    struct hash<sge::vulkan_pipeline_key> {
+        size_t operator()(const sge::vulkan_pipeline_key& key) const {
+            size_t result = hash<sge::guid>()(key.shader);
+            result ^= hash<sge::vulkan_render_pass*>()(key.renderpass) + 0x9e3779b9 +
+                      (result << 6) + (result >> 2);
+            result ^= key.input_layout_hash + 0x9e3779b9 + (result << 6) + (result >> 2);
+            result ^= key.state_hash + 0x9e3779b9 + (result << 6) + (result >> 2);
+            return result;
+        }
+    };
+} // namespace std
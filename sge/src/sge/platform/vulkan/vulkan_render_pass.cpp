@@ -20,6 +20,7 @@
 #include "sge/platform/vulkan/vulkan_context.h"
 #include "sge/platform/vulkan/vulkan_command_list.h"
 #include "sge/platform/vulkan/vulkan_image.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
 namespace sge {
     vulkan_render_pass::vulkan_render_pass(vulkan_swapchain* parent) {
         m_swapchain_parent = parent;
@@ -138,6 +139,8 @@ namespace sge {
     }
 
     vulkan_render_pass::~vulkan_render_pass() {
+        vulkan_pipeline_cache::evict(this);
+
         VkDevice device = vulkan_context::get().get_device().get();
         vkDestroyRenderPass(device, m_render_pass, nullptr);
     }
@@ -22,6 +22,7 @@
 #include "sge/platform/vulkan/vulkan_vertex_buffer.h"
 #include "sge/platform/vulkan/vulkan_index_buffer.h"
 #include "sge/platform/vulkan/vulkan_pipeline.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
 #include "sge/core/application.h"
 namespace sge {
     void vulkan_renderer::init() { vulkan_context::create(VK_API_VERSION_1_1); }
@@ -41,7 +42,7 @@ namespace sge {
 
         auto vk_vertex_buffer = data.vertices.as<vulkan_vertex_buffer>();
         VkBuffer vbo = vk_vertex_buffer->get()->get();
-        VkDeviceSize offset = 0;
+        VkDeviceSize offset = data.vertex_offset;
         vkCmdBindVertexBuffers(cmdbuffer, 0, 1, &vbo, &offset);
 
         auto vk_index_buffer = data.indices.as<vulkan_index_buffer>();
@@ -62,7 +63,20 @@ namespace sge {
                                     set, 1, &data[current_image], 0, nullptr);
         }
 
-        vkCmdDrawIndexed(cmdbuffer, data.indices->get_index_count(), 1, 0, 0, 0);
+        uint32_t index_count = data.index_count;
+        if (index_count == 0) {
+            index_count = (uint32_t)data.indices->get_index_count();
+        }
+
+        vkCmdDrawIndexed(cmdbuffer, index_count, data.instance_count, 0, 0, 0);
+    }
+
+    bool vulkan_renderer::load_pipeline_cache(const fs::path& path) {
+        return vulkan_pipeline_cache::load(path);
+    }
+
+    bool vulkan_renderer::save_pipeline_cache(const fs::path& path) {
+        return vulkan_pipeline_cache::save(path);
     }
 
     device_info vulkan_renderer::query_device_info() {
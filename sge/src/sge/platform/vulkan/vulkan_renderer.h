@@ -25,6 +25,9 @@ namespace sge {
 
         virtual void submit(const draw_data& data) override;
 
+        virtual bool load_pipeline_cache(const fs::path& path) override;
+        virtual bool save_pipeline_cache(const fs::path& path) override;
+
         virtual device_info query_device_info() override;
     };
 } // namespace sge
\ No newline at end of file
@@ -18,7 +18,9 @@
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_shader.h"
 #include "sge/platform/vulkan/vulkan_context.h"
+#include "sge/platform/vulkan/vulkan_pipeline_cache.h"
 #include "sge/renderer/renderer.h"
+#include "sge/core/environment.h"
 #include <shaderc/shaderc.hpp>
 #include <spirv_glsl.hpp>
 namespace sge {
@@ -96,31 +98,78 @@ namespace sge {
         create();
     }
 
-    vulkan_shader::~vulkan_shader() { destroy(); }
+    vulkan_shader::~vulkan_shader() {
+        vulkan_pipeline_cache::evict(id);
+        destroy();
+    }
 
     bool vulkan_shader::reload() {
-        destroy();
-        create();
+        if (!recompile()) {
+            return false;
+        }
 
-        renderer::on_shader_reloaded(id);
+        apply_recompiled();
         return true;
     }
 
-    void vulkan_shader::create() {
-        std::map<shader_stage, std::string> sources;
-        parse_source(m_path, sources);
+    bool vulkan_shader::recompile() {
+        compiled_source_t compiled;
+        try {
+            compile_source(compiled);
+        } catch (const std::exception& exc) {
+            spdlog::error("failed to recompile shader {0}: {1}", m_path.string(), exc.what());
+            return false;
+        }
 
-        for (const auto& [stage, source] : sources) {
-            auto stage_info = vk_init<VkPipelineShaderStageCreateInfo>(
-                VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO);
+        std::lock_guard lock(m_recompiled_mutex);
+        m_recompiled = std::move(compiled);
+        return true;
+    }
 
-            stage_info.pName = "main";
-            stage_info.stage = get_shader_stage_flags(stage);
-            stage_info.module = compile(stage, source);
+    void vulkan_shader::apply_recompiled() {
+        std::optional<compiled_source_t> compiled;
+        {
+            std::lock_guard lock(m_recompiled_mutex);
+            compiled.swap(m_recompiled);
+        }
 
-            m_pipeline_info.push_back(stage_info);
+        if (!compiled.has_value()) {
+            return;
         }
 
+        // pipelines keep working without their modules, and dependent pipelines retire
+        // themselves through renderer::retire when they are invalidated
+        destroy();
+        create_modules(compiled.value());
+
+        vulkan_pipeline_cache::evict(id);
+        renderer::on_shader_reloaded(id);
+    }
+
+    uint32_t vulkan_shader::get_texture_capacity(uint32_t binding) {
+        std::optional<uint32_t> capacity;
+
+        for (const auto& [name, resource] : m_reflection_data.resources) {
+            if (resource.set != 0 || resource.binding != binding) {
+                continue;
+            }
+
+            // separate images and samplers are combined, so the smaller array is the limit
+            if (resource.type == resource_type::image || resource.type == resource_type::sampler ||
+                resource.type == resource_type::sampled_image) {
+                uint32_t count = (uint32_t)resource.descriptor_count;
+                capacity = capacity.has_value() ? std::min(capacity.value(), count) : count;
+            }
+        }
+
+        return capacity.value_or(0);
+    }
+
+    void vulkan_shader::create() {
+        compiled_source_t compiled;
+        compile_source(compiled);
+        create_modules(compiled);
+
         { 
             size_t ubo_count = 0;
             size_t ssbo_count = 0;
@@ -173,9 +222,221 @@ namespace sge {
         m_reflection_data.push_constant_buffer = push_constant_range();
     }
 
+    struct shader_binary_t {
+        std::vector<uint32_t> spirv;
+        vulkan_shader::reflection_data reflection;
+    };
+
+    static void map_resources(const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
+                              vulkan_shader::reflection_data& reflection_data, shader_stage stage,
+                              vulkan_shader::resource_type type, spirv_cross::Compiler& compiler) {
+        for (const auto& resource : resources) {
+            vulkan_shader::resource data;
+            data.set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+            data.binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
+            data.type = type;
+            data.stage = stage;
+            data.size = 0;
+
+            const auto& type = compiler.get_type(resource.type_id);
+            if (type.array.empty()) {
+                data.descriptor_count = 1;
+            } else {
+                data.descriptor_count = type.array[0];
+            }
+
+            if (type.basetype == spirv_cross::SPIRType::BaseType::Struct) {
+                data.size = compiler.get_declared_struct_size(type);
+            }
+
+            std::string name = compiler.get_name(resource.id);
+            if (reflection_data.resources.find(name) != reflection_data.resources.end()) {
+                throw std::runtime_error("a resource named " + name + " has already been defined!");
+            }
+            reflection_data.resources.insert(std::make_pair(name, data));
+        }
+    }
+
+    static void reflect(const std::vector<uint32_t>& spirv, shader_stage stage,
+                        vulkan_shader::reflection_data& reflection_data) {
+        spirv_cross::Compiler compiler(spirv);
+        auto resources = compiler.get_shader_resources();
+
+        using resource_type = vulkan_shader::resource_type;
+        map_resources(resources.uniform_buffers, reflection_data, stage,
+                      resource_type::uniform_buffer, compiler);
+        map_resources(resources.storage_buffers, reflection_data, stage,
+                      resource_type::storage_buffer, compiler);
+        map_resources(resources.sampled_images, reflection_data, stage,
+                      resource_type::sampled_image, compiler);
+        map_resources(resources.separate_images, reflection_data, stage, resource_type::image,
+                      compiler);
+        map_resources(resources.separate_samplers, reflection_data, stage, resource_type::sampler,
+                      compiler);
+
+        for (const auto& spirv_resource : resources.push_constant_buffers) {
+            const auto& spirv_type = compiler.get_type(spirv_resource.type_id);
+            size_t size = compiler.get_declared_struct_size(spirv_type);
+            reflection_data.push_constant_buffer.size += size;
+
+            VkShaderStageFlagBits stage_flags = vulkan_shader::get_shader_stage_flags(stage);
+            reflection_data.push_constant_buffer.stage |= stage_flags;
+        }
+    }
+
+    static void merge_reflection_data(const vulkan_shader::reflection_data& src,
+                                      vulkan_shader::reflection_data& dst) {
+        for (const auto& [name, data] : src.resources) {
+            if (dst.resources.find(name) != dst.resources.end()) {
+                throw std::runtime_error("a resource named " + name + " has already been defined!");
+            }
+            dst.resources.insert(std::make_pair(name, data));
+        }
+
+        dst.push_constant_buffer.size += src.push_constant_buffer.size;
+        dst.push_constant_buffer.stage |= src.push_constant_buffer.stage;
+    }
+
+    // bump whenever the cache format or the compile options change
+    static constexpr uint32_t shader_cache_version = 1;
+    static constexpr uint32_t shader_cache_magic = 0x43534753; // "SGSC"
+
+    static fs::path get_shader_cache_directory() {
+        return environment::get_home_directory() / ".sge" / "shader_cache";
+    }
+
+    // fnv-1a
+    static uint64_t hash_source(const std::string& data) {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (char c : data) {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    class binary_reader {
+    public:
+        binary_reader(std::istream& stream) : m_stream(stream) {}
+
+        template <typename T>
+        T read() {
+            T value;
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        void read(void* data, size_t size) {
+            m_stream.read((char*)data, size);
+            if (!m_stream) {
+                throw std::runtime_error("unexpected end of file!");
+            }
+        }
+
+    private:
+        std::istream& m_stream;
+    };
+
+    template <typename T>
+    static void write_value(std::ostream& stream, const T& value) {
+        stream.write((const char*)&value, sizeof(T));
+    }
+
+    static bool read_cached_binary(const fs::path& path, shader_binary_t& binary) {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        if (!stream.is_open()) {
+            return false;
+        }
+
+        try {
+            binary_reader reader(stream);
+            if (reader.read<uint32_t>() != shader_cache_magic ||
+                reader.read<uint32_t>() != shader_cache_version) {
+                return false;
+            }
+
+            binary.spirv.resize(reader.read<uint64_t>());
+            reader.read(binary.spirv.data(), binary.spirv.size() * sizeof(uint32_t));
+
+            auto& reflection = binary.reflection;
+            reflection.push_constant_buffer.size = reader.read<uint64_t>();
+            reflection.push_constant_buffer.stage = reader.read<uint32_t>();
+
+            uint64_t resource_count = reader.read<uint64_t>();
+            for (uint64_t i = 0; i < resource_count; i++) {
+                std::string name(reader.read<uint64_t>(), '\0');
+                reader.read(name.data(), name.length());
+
+                vulkan_shader::resource data;
+                data.set = reader.read<uint32_t>();
+                data.binding = reader.read<uint32_t>();
+                data.type = (vulkan_shader::resource_type)reader.read<uint32_t>();
+                data.size = reader.read<uint64_t>();
+                data.descriptor_count = reader.read<uint64_t>();
+                data.stage = (shader_stage)reader.read<uint32_t>();
+
+                reflection.resources.insert(std::make_pair(name, data));
+            }
+        } catch (const std::exception& exc) {
+            spdlog::warn("corrupt shader cache entry {0}: {1}", path.string(), exc.what());
+
+            binary = shader_binary_t();
+            return false;
+        }
+
+        return true;
+    }
+
+    static void write_cached_binary(const fs::path& path, const shader_binary_t& binary) {
+        std::error_code error;
+        fs::create_directories(path.parent_path(), error);
+
+        // write to a temporary file first so that no one else reads a partial entry
+        size_t thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+        fs::path temp_path = path;
+        temp_path += "." + std::to_string(environment::get_process_id()) + "." +
+                     std::to_string(thread_id) + ".tmp";
+
+        std::ofstream stream(temp_path, std::ios::out | std::ios::binary);
+        if (!stream.is_open()) {
+            spdlog::warn("could not write shader cache entry: {0}", path.string());
+            return;
+        }
+
+        write_value(stream, shader_cache_magic);
+        write_value(stream, shader_cache_version);
+
+        write_value(stream, (uint64_t)binary.spirv.size());
+        stream.write((const char*)binary.spirv.data(), binary.spirv.size() * sizeof(uint32_t));
+
+        const auto& reflection = binary.reflection;
+        write_value(stream, (uint64_t)reflection.push_constant_buffer.size);
+        write_value(stream, (uint32_t)reflection.push_constant_buffer.stage);
+
+        write_value(stream, (uint64_t)reflection.resources.size());
+        for (const auto& [name, data] : reflection.resources) {
+            write_value(stream, (uint64_t)name.length());
+            stream.write(name.data(), name.length());
+
+            write_value(stream, data.set);
+            write_value(stream, data.binding);
+            write_value(stream, (uint32_t)data.type);
+            write_value(stream, (uint64_t)data.size);
+            write_value(stream, (uint64_t)data.descriptor_count);
+            write_value(stream, (uint32_t)data.stage);
+        }
+
+        stream.close();
+        fs::rename(temp_path, path, error);
+        if (error) {
+            fs::remove(temp_path, error);
+        }
+    }
+
     static void compile_shader(shader_stage stage, const std::string& source,
                                shader_language language, const fs::path& path,
-                               std::vector<uint32_t>& spirv) {
+                               shader_binary_t& binary) {
         shaderc::Compiler compiler;
         shaderc::CompileOptions options;
 
@@ -217,86 +478,80 @@ namespace sge {
             throw std::runtime_error("invalid shader stage!");
         }
 
+        // the preprocessed source has every include expanded, so it covers all dependencies
         std::string string_path = path.string();
-        auto result = compiler.CompileGlslToSpv(source, kind, string_path.c_str(), "main", options);
+        auto preprocessed = compiler.PreprocessGlsl(source, kind, string_path.c_str(), options);
+        if (preprocessed.GetCompilationStatus() != shaderc_compilation_status_success) {
+            throw std::runtime_error("could not preprocess " + stage_name + " shader " +
+                                     string_path + ": " + preprocessed.GetErrorMessage());
+        }
+        std::string preprocessed_source(preprocessed.cbegin(), preprocessed.cend());
+
+        fs::path cache_path;
+        {
+            std::stringstream key;
+            key << shader_cache_version << ';' << (uint32_t)language << ';' << (uint32_t)stage
+                << ';' << vulkan_version << ';' << preprocessed_source;
+
+            std::stringstream filename;
+            filename << std::hex << hash_source(key.str()) << ".bin";
+            cache_path = get_shader_cache_directory() / filename.str();
+        }
+
+        if (read_cached_binary(cache_path, binary)) {
+            return;
+        }
+
+        auto result = compiler.CompileGlslToSpv(preprocessed_source, kind, string_path.c_str(),
+                                                "main", options);
 
         if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
             throw std::runtime_error("could not compile " + stage_name + " shader " + string_path +
                                      ": " + result.GetErrorMessage());
         }
 
-        spirv = std::vector<uint32_t>(result.cbegin(), result.cend());
-    }
+        binary.spirv = std::vector<uint32_t>(result.cbegin(), result.cend());
+        reflect(binary.spirv, stage, binary.reflection);
 
-    VkShaderModule vulkan_shader::compile(shader_stage stage, const std::string& source) {
-        std::vector<uint32_t> spirv;
-        compile_shader(stage, source, m_language, m_path, spirv);
-        reflect(spirv, stage);
+        write_cached_binary(cache_path, binary);
+    }
 
-        auto create_info =
-            vk_init<VkShaderModuleCreateInfo>(VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO);
+    void vulkan_shader::compile_source(compiled_source_t& compiled) {
+        std::map<shader_stage, std::string> sources;
+        parse_source(m_path, sources);
 
-        create_info.pCode = spirv.data();
-        create_info.codeSize = spirv.size() * sizeof(uint32_t);
+        for (const auto& [stage, source] : sources) {
+            shader_binary_t binary;
+            compile_shader(stage, source, m_language, m_path, binary);
+            merge_reflection_data(binary.reflection, compiled.reflection);
 
-        VkDevice device = vulkan_context::get().get_device().get();
-        VkShaderModule module;
-        VkResult result = vkCreateShaderModule(device, &create_info, nullptr, &module);
-        check_vk_result(result);
-        return module;
+            compiled.spirv.insert(std::make_pair(stage, std::move(binary.spirv)));
+        }
     }
 
-    static void map_resources(const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
-                              vulkan_shader::reflection_data& reflection_data, shader_stage stage,
-                              vulkan_shader::resource_type type, spirv_cross::Compiler& compiler) {
-        for (const auto& resource : resources) {
-            vulkan_shader::resource data;
-            data.set = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
-            data.binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
-            data.type = type;
-            data.stage = stage;
-
-            const auto& type = compiler.get_type(resource.type_id);
-            if (type.array.empty()) {
-                data.descriptor_count = 1;
-            } else {
-                data.descriptor_count = type.array[0];
-            }
+    void vulkan_shader::create_modules(const compiled_source_t& compiled) {
+        VkDevice device = vulkan_context::get().get_device().get();
 
-            if (type.basetype == spirv_cross::SPIRType::BaseType::Struct) {
-                data.size = compiler.get_declared_struct_size(type);
-            }
+        for (const auto& [stage, spirv] : compiled.spirv) {
+            auto create_info =
+                vk_init<VkShaderModuleCreateInfo>(VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO);
 
-            std::string name = compiler.get_name(resource.id);
-            if (reflection_data.resources.find(name) != reflection_data.resources.end()) {
-                throw std::runtime_error("a resource named " + name + " has already been defined!");
-            }
-            reflection_data.resources.insert(std::make_pair(name, data));
-        }
-    }
+            create_info.pCode = spirv.data();
+            create_info.codeSize = spirv.size() * sizeof(uint32_t);
 
-    void vulkan_shader::reflect(const std::vector<uint32_t>& spirv, shader_stage stage) {
-        spirv_cross::Compiler compiler(std::move(spirv));
-        auto resources = compiler.get_shader_resources();
+            auto stage_info = vk_init<VkPipelineShaderStageCreateInfo>(
+                VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO);
 
-        map_resources(resources.uniform_buffers, m_reflection_data, stage,
-                      resource_type::uniform_buffer, compiler);
-        map_resources(resources.storage_buffers, m_reflection_data, stage,
-                      resource_type::storage_buffer, compiler);
-        map_resources(resources.sampled_images, m_reflection_data, stage,
-                      resource_type::sampled_image, compiler);
-        map_resources(resources.separate_images, m_reflection_data, stage,
-                      resource_type::image, compiler);
-        map_resources(resources.separate_samplers, m_reflection_data, stage,
-                      resource_type::sampler, compiler);
+            stage_info.pName = "main";
+            stage_info.stage = get_shader_stage_flags(stage);
 
-        for (const auto& spirv_resource : resources.push_constant_buffers) {
-            const auto& spirv_type = compiler.get_type(spirv_resource.type_id);
-            size_t size = compiler.get_declared_struct_size(spirv_type);
-            m_reflection_data.push_constant_buffer.size += size;
+            VkResult result =
+                vkCreateShaderModule(device, &create_info, nullptr, &stage_info.module);
+            check_vk_result(result);
 
-            VkShaderStageFlagBits stage_flags = get_shader_stage_flags(stage);
-            m_reflection_data.push_constant_buffer.stage |= stage_flags;
+            m_pipeline_info.push_back(stage_info);
         }
+
+        m_reflection_data = compiled.reflection;
     }
 } // namespace sge
\ No newline at end of file
@@ -47,24 +47,38 @@ namespace sge {
         virtual ~vulkan_shader() override;
 
         virtual bool reload() override;
+
+        virtual bool recompile() override;
+        virtual void apply_recompiled() override;
         virtual const fs::path& get_path() override { return m_path; }
 
+        virtual uint32_t get_texture_capacity(uint32_t binding) override;
+
         const std::vector<VkPipelineShaderStageCreateInfo>& get_pipeline_info() {
             return m_pipeline_info;
         }
         const reflection_data& get_reflection_data() { return m_reflection_data; }
 
     private:
+        struct compiled_source_t {
+            std::map<shader_stage, std::vector<uint32_t>> spirv;
+            reflection_data reflection;
+        };
+
         void create();
         void destroy();
 
-        VkShaderModule compile(shader_stage stage, const std::string& source);
-        void reflect(const std::vector<uint32_t>& spirv, shader_stage stage);
+        void compile_source(compiled_source_t& compiled);
+        void create_modules(const compiled_source_t& compiled);
 
         fs::path m_path;
         shader_language m_language;
 
         std::vector<VkPipelineShaderStageCreateInfo> m_pipeline_info;
         reflection_data m_reflection_data;
+
+        // written by recompile, which may run on another thread
+        std::optional<compiled_source_t> m_recompiled;
+        std::mutex m_recompiled_mutex;
     };
 } // namespace sge
\ No newline at end of file
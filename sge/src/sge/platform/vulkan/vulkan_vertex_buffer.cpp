@@ -38,4 +38,21 @@ namespace sge {
             VMA_MEMORY_USAGE_GPU_ONLY);
         staging_buffer->copy_to(m_buffer, region);
     }
+
+    vulkan_vertex_buffer::vulkan_vertex_buffer(size_t size) {
+        m_stride = 1;
+        m_count = size;
+
+        m_buffer = ref<vulkan_buffer>::create(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                              VMA_MEMORY_USAGE_CPU_TO_GPU);
+        m_buffer->map();
+    }
+
+    void vulkan_vertex_buffer::flush(size_t offset, size_t size) {
+        if (m_buffer->mapped == nullptr) {
+            throw std::runtime_error("cannot flush a static vertex buffer!");
+        }
+
+        m_buffer->flush(offset, size);
+    }
 } // namespace sge
\ No newline at end of file
@@ -21,11 +21,15 @@ namespace sge {
     class vulkan_vertex_buffer : public vertex_buffer {
     public:
         vulkan_vertex_buffer(const void* data, size_t stride, size_t count);
+        vulkan_vertex_buffer(size_t size);
         virtual ~vulkan_vertex_buffer() override = default;
 
         virtual size_t get_vertex_stride() override { return m_stride; }
         virtual size_t get_vertex_count() override { return m_count; }
 
+        virtual void* get_mapped_data() override { return m_buffer->mapped; }
+        virtual void flush(size_t offset, size_t size) override;
+
         ref<vulkan_buffer> get() { return m_buffer; }
 
     private:
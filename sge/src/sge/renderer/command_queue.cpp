@@ -16,12 +16,18 @@
 
 #include "sgepch.h"
 #include "sge/renderer/command_queue.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_command_queue.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_command_queue.h"
 #endif
 namespace sge {
     ref<command_queue> command_queue::create(command_list_type type) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_command_queue>::create(type);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_command_queue>::create(type);
 #endif
@@ -16,6 +16,8 @@
 
 #include "sgepch.h"
 #include "sge/renderer/framebuffer.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_framebuffer.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_framebuffer.h"
@@ -26,6 +28,10 @@ namespace sge {
             throw std::runtime_error("cannot create a framebuffer from no attachments!");
         }
         
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_framebuffer>::create(spec);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_framebuffer>::create(spec);
 #endif
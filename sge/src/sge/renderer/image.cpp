@@ -16,6 +16,8 @@
 
 #include "sgepch.h"
 #include "sge/renderer/image.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_texture.h"
 
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
@@ -160,6 +162,10 @@ namespace sge {
     }
 
     ref<image_2d> image_2d::create(const image_spec& spec) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_image_2d>::create(spec);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_image_2d>::create(spec);
 #endif
@@ -16,12 +16,18 @@
 
 #include "sgepch.h"
 #include "sge/renderer/index_buffer.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_buffer.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_index_buffer.h"
 #endif
 namespace sge {
     ref<index_buffer> index_buffer::create(const uint32_t* data, size_t count) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_index_buffer>::create(data, count);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_index_buffer>::create(data, count);
 #endif
@@ -16,12 +16,18 @@
 
 #include "sgepch.h"
 #include "sge/renderer/pipeline.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_pipeline.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_pipeline.h"
 #endif
 namespace sge {
     ref<pipeline> pipeline::create(const pipeline_spec& spec) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_pipeline>::create(spec);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_pipeline>::create(spec);
 #endif
@@ -41,9 +41,12 @@ namespace sge {
         size_t offset;
     };
 
+    enum class vertex_input_rate { vertex, instance };
+
     struct pipeline_input_layout {
         size_t stride = 0;
         std::vector<vertex_attribute> attributes;
+        vertex_input_rate input_rate = vertex_input_rate::vertex;
     };
 
     struct pipeline_spec {
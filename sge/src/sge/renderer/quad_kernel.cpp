@@ -0,0 +1,283 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sgepch.h"
+#include "sge/renderer/quad_kernel.h"
+
+// AVX2 is opt-in through SGE_USE_AVX2, which only affects this file
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SGE_QUAD_KERNEL_AVX2
+#define SGE_QUAD_KERNEL_SIMD
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SGE_QUAD_KERNEL_SSE2
+#define SGE_QUAD_KERNEL_SIMD
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SGE_QUAD_KERNEL_NEON
+#define SGE_QUAD_KERNEL_SIMD
+#endif
+
+namespace sge {
+    static constexpr float deg_to_rad = 0.01745329251994329577f;
+
+    // corners are stored top right, bottom right, bottom left, top left, as x/y pairs
+    static void write_quad(const quad_list& quads, size_t index, const float* corners,
+                           quad_vertex* vertices) {
+        static const glm::vec2 uvs[4] = { glm::vec2(1.f, 0.f), glm::vec2(1.f, 1.f),
+                                          glm::vec2(0.f, 1.f), glm::vec2(0.f, 0.f) };
+
+        const glm::vec4& color = quads.color[index];
+        int32_t texture_index = quads.texture_index[index];
+
+        for (size_t i = 0; i < 4; i++) {
+            auto& v = vertices[i];
+            v.position = glm::vec2(corners[i * 2], corners[i * 2 + 1]);
+            v.color = color;
+            v.uv = uvs[i];
+            v.texture_index = texture_index;
+        }
+    }
+
+    static void generate_scalar(const quad_list& quads, size_t begin, size_t end,
+                                quad_vertex* vertices) {
+        for (size_t i = begin; i < end; i++) {
+            float rot_rad = quads.rotation[i] * deg_to_rad;
+            float cos_rot = std::cos(rot_rad);
+            float sin_rot = std::sin(rot_rad);
+
+            float half_width = quads.width[i] / 2.f;
+            float half_height = quads.height[i] / 2.f;
+
+            float a = half_width * cos_rot;
+            float b = half_height * sin_rot;
+            float d = half_width * sin_rot;
+            float e = half_height * cos_rot;
+
+            float x = quads.x[i];
+            float y = quads.y[i];
+
+            float corners[8] = { x + (a - b), y + (d + e), x + (a + b), y + (d - e),
+                                 x - (a - b), y - (d + e), x - (a + b), y - (d - e) };
+
+            write_quad(quads, i, corners, &vertices[i * 4]);
+        }
+    }
+
+#if defined(SGE_QUAD_KERNEL_AVX2)
+    struct simd_t {
+        using f = __m256;
+        using i = __m256i;
+        static constexpr size_t width = 8;
+
+        static f load(const float* data) { return _mm256_loadu_ps(data); }
+        static void store(float* data, f v) { _mm256_storeu_ps(data, v); }
+        static f set(float value) { return _mm256_set1_ps(value); }
+
+        static f add(f a, f b) { return _mm256_add_ps(a, b); }
+        static f sub(f a, f b) { return _mm256_sub_ps(a, b); }
+        static f mul(f a, f b) { return _mm256_mul_ps(a, b); }
+        static f mul_add(f a, f b, f c) { return _mm256_fmadd_ps(a, b, c); }
+
+        static i round_to_int(f v) { return _mm256_cvtps_epi32(v); }
+        static f to_float(i v) { return _mm256_cvtepi32_ps(v); }
+        static i add_int(i v, int32_t value) {
+            return _mm256_add_epi32(v, _mm256_set1_epi32(value));
+        }
+
+        // all bits set in each lane where (v & bit) != 0
+        static f test_bit(i v, int32_t bit) {
+            i mask = _mm256_set1_epi32(bit);
+            return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(v, mask), mask));
+        }
+
+        static f select(f mask, f a, f b) { return _mm256_blendv_ps(b, a, mask); }
+        static f negate(f mask, f v) {
+            return _mm256_xor_ps(v, _mm256_and_ps(mask, _mm256_set1_ps(-0.f)));
+        }
+    };
+#elif defined(SGE_QUAD_KERNEL_SSE2)
+    struct simd_t {
+        using f = __m128;
+        using i = __m128i;
+        static constexpr size_t width = 4;
+
+        static f load(const float* data) { return _mm_loadu_ps(data); }
+        static void store(float* data, f v) { _mm_storeu_ps(data, v); }
+        static f set(float value) { return _mm_set1_ps(value); }
+
+        static f add(f a, f b) { return _mm_add_ps(a, b); }
+        static f sub(f a, f b) { return _mm_sub_ps(a, b); }
+        static f mul(f a, f b) { return _mm_mul_ps(a, b); }
+        static f mul_add(f a, f b, f c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+        static i round_to_int(f v) { return _mm_cvtps_epi32(v); }
+        static f to_float(i v) { return _mm_cvtepi32_ps(v); }
+        static i add_int(i v, int32_t value) { return _mm_add_epi32(v, _mm_set1_epi32(value)); }
+
+        static f test_bit(i v, int32_t bit) {
+            i mask = _mm_set1_epi32(bit);
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(v, mask), mask));
+        }
+
+        static f select(f mask, f a, f b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        static f negate(f mask, f v) { return _mm_xor_ps(v, _mm_and_ps(mask, _mm_set1_ps(-0.f))); }
+    };
+#elif defined(SGE_QUAD_KERNEL_NEON)
+    struct simd_t {
+        using f = float32x4_t;
+        using i = int32x4_t;
+        static constexpr size_t width = 4;
+
+        static f load(const float* data) { return vld1q_f32(data); }
+        static void store(float* data, f v) { vst1q_f32(data, v); }
+        static f set(float value) { return vdupq_n_f32(value); }
+
+        static f add(f a, f b) { return vaddq_f32(a, b); }
+        static f sub(f a, f b) { return vsubq_f32(a, b); }
+        static f mul(f a, f b) { return vmulq_f32(a, b); }
+        static f mul_add(f a, f b, f c) { return vfmaq_f32(c, a, b); }
+
+        static i round_to_int(f v) { return vcvtnq_s32_f32(v); }
+        static f to_float(i v) { return vcvtq_f32_s32(v); }
+        static i add_int(i v, int32_t value) { return vaddq_s32(v, vdupq_n_s32(value)); }
+
+        static f test_bit(i v, int32_t bit) {
+            return vreinterpretq_f32_u32(vtstq_s32(v, vdupq_n_s32(bit)));
+        }
+
+        static f select(f mask, f a, f b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+        static f negate(f mask, f v) {
+            uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(mask), vdupq_n_u32(0x80000000));
+            return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), sign));
+        }
+    };
+#endif
+
+#ifdef SGE_QUAD_KERNEL_SIMD
+    using simd_float = simd_t::f;
+
+    // cephes-style sincos: reduce to [-pi/4, pi/4] around the nearest multiple of pi/2, evaluate
+    // both minimax polynomials and swap/negate per quadrant
+    static void simd_sincos(simd_float x, simd_float& sin_x, simd_float& cos_x) {
+        using v = simd_t;
+
+        auto quadrant = v::round_to_int(v::mul(x, v::set(0.63661977236758134f)));
+        simd_float q = v::to_float(quadrant);
+
+        simd_float r = v::sub(x, v::mul(q, v::set(1.5703125f)));
+        r = v::sub(r, v::mul(q, v::set(4.837512969970703125e-4f)));
+        r = v::sub(r, v::mul(q, v::set(7.54978995489188216e-8f)));
+        simd_float z = v::mul(r, r);
+
+        simd_float s = v::set(-1.9515295891e-4f);
+        s = v::mul_add(s, z, v::set(8.3321608736e-3f));
+        s = v::mul_add(s, z, v::set(-1.6666654611e-1f));
+        s = v::mul_add(v::mul(s, z), r, r);
+
+        simd_float c = v::set(2.443315711809948e-5f);
+        c = v::mul_add(c, z, v::set(-1.388731625493765e-3f));
+        c = v::mul_add(c, z, v::set(4.166664568298827e-2f));
+        c = v::mul(v::mul(c, z), z);
+        c = v::sub(c, v::mul(z, v::set(0.5f)));
+        c = v::add(c, v::set(1.f));
+
+        simd_float swap = v::test_bit(quadrant, 1);
+        sin_x = v::select(swap, c, s);
+        cos_x = v::select(swap, s, c);
+
+        sin_x = v::negate(v::test_bit(quadrant, 2), sin_x);
+        cos_x = v::negate(v::test_bit(v::add_int(quadrant, 1), 2), cos_x);
+    }
+
+    static void generate_simd(const quad_list& quads, size_t begin, size_t end,
+                              quad_vertex* vertices) {
+        using v = simd_t;
+        static constexpr size_t width = simd_t::width;
+
+        float corners[8][width];
+        float quad_corners[8];
+
+        size_t i = begin;
+        for (; i + width <= end; i += width) {
+            simd_float rotation = v::mul(v::load(&quads.rotation[i]), v::set(deg_to_rad));
+
+            simd_float sin_rot, cos_rot;
+            simd_sincos(rotation, sin_rot, cos_rot);
+
+            simd_float half_width = v::mul(v::load(&quads.width[i]), v::set(0.5f));
+            simd_float half_height = v::mul(v::load(&quads.height[i]), v::set(0.5f));
+
+            simd_float a = v::mul(half_width, cos_rot);
+            simd_float b = v::mul(half_height, sin_rot);
+            simd_float d = v::mul(half_width, sin_rot);
+            simd_float e = v::mul(half_height, cos_rot);
+
+            simd_float a_minus_b = v::sub(a, b);
+            simd_float a_plus_b = v::add(a, b);
+            simd_float d_plus_e = v::add(d, e);
+            simd_float d_minus_e = v::sub(d, e);
+
+            simd_float x = v::load(&quads.x[i]);
+            simd_float y = v::load(&quads.y[i]);
+
+            v::store(corners[0], v::add(x, a_minus_b));
+            v::store(corners[1], v::add(y, d_plus_e));
+            v::store(corners[2], v::add(x, a_plus_b));
+            v::store(corners[3], v::add(y, d_minus_e));
+            v::store(corners[4], v::sub(x, a_minus_b));
+            v::store(corners[5], v::sub(y, d_plus_e));
+            v::store(corners[6], v::sub(x, a_plus_b));
+            v::store(corners[7], v::sub(y, d_minus_e));
+
+            for (size_t j = 0; j < width; j++) {
+                for (size_t k = 0; k < 8; k++) {
+                    quad_corners[k] = corners[k][j];
+                }
+
+                write_quad(quads, i + j, quad_corners, &vertices[(i + j) * 4]);
+            }
+        }
+
+        generate_scalar(quads, i, end, vertices);
+    }
+#endif
+
+    void quad_kernel::generate_vertices(const quad_list& quads, size_t begin, size_t end,
+                                        quad_vertex* vertices) {
+#ifdef SGE_QUAD_KERNEL_SIMD
+        generate_simd(quads, begin, end, vertices);
+#else
+        generate_scalar(quads, begin, end, vertices);
+#endif
+    }
+
+    const char* quad_kernel::get_instruction_set() {
+#if defined(SGE_QUAD_KERNEL_AVX2)
+        return "AVX2";
+#elif defined(SGE_QUAD_KERNEL_SSE2)
+        return "SSE2";
+#elif defined(SGE_QUAD_KERNEL_NEON)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+} // namespace sge
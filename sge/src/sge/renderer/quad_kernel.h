@@ -0,0 +1,59 @@
+/*
+   Copyright 2022 Nora Beda and SGE contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+namespace sge {
+    struct quad_vertex {
+        glm::vec2 position;
+        glm::vec4 color;
+        glm::vec2 uv;
+        int32_t texture_index;
+    };
+
+    // Quads are stored as a structure of arrays so that their transforms can be computed several
+    // at a time. Rotation is in degrees.
+    struct quad_list {
+        std::vector<float> x, y, width, height, rotation;
+        std::vector<glm::vec4> color;
+        std::vector<int32_t> texture_index;
+
+        size_t size() const { return x.size(); }
+        bool empty() const { return x.empty(); }
+
+        void push_back(glm::vec2 position, glm::vec2 size, float rotation_,
+                       const glm::vec4& color_, int32_t texture_index_) {
+            x.push_back(position.x);
+            y.push_back(position.y);
+            width.push_back(size.x);
+            height.push_back(size.y);
+            rotation.push_back(rotation_);
+            color.push_back(color_);
+            texture_index.push_back(texture_index_);
+        }
+    };
+
+    class quad_kernel {
+    public:
+        quad_kernel() = delete;
+
+        // Writes four vertices for each quad in [begin, end), starting at vertices[begin * 4].
+        // Disjoint ranges may be generated concurrently.
+        static void generate_vertices(const quad_list& quads, size_t begin, size_t end,
+                                      quad_vertex* vertices);
+
+        static const char* get_instruction_set();
+    };
+} // namespace sge
@@ -17,40 +17,60 @@
 #include "sgepch.h"
 #include "sge/renderer/renderer.h"
 #include "sge/renderer/shader.h"
+#include "sge/renderer/quad_kernel.h"
 #include "sge/core/application.h"
+#include "sge/core/thread_pool.h"
+#include "sge/core/profiler.h"
+#include <future>
+#include "sge/platform/null/null_renderer.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_renderer.h"
 #endif
 namespace sge {
-    struct vertex {
-        glm::vec2 position;
+    // per-quad record for the instanced path; corners are generated in default_instanced.hlsl
+    struct instance_t {
+        glm::vec2 position, size;
+        float rotation;
         glm::vec4 color;
-        glm::vec2 uv;
         int32_t texture_index;
     };
 
-    struct quad_t {
-        glm::vec2 position, size;
-        float rotation;
-        glm::vec4 color;
-        size_t texture_index;
+    static const pipeline_input_layout vertex_layout = {
+        sizeof(quad_vertex),
+        {
+            { vertex_attribute_type::float2, offsetof(quad_vertex, position) },
+            { vertex_attribute_type::float4, offsetof(quad_vertex, color) },
+            { vertex_attribute_type::float2, offsetof(quad_vertex, uv) },
+            { vertex_attribute_type::int1, offsetof(quad_vertex, texture_index) },
+        },
+        vertex_input_rate::vertex
+    };
+
+    static const pipeline_input_layout instance_layout = {
+        sizeof(instance_t),
+        {
+            { vertex_attribute_type::float2, offsetof(instance_t, position) },
+            { vertex_attribute_type::float2, offsetof(instance_t, size) },
+            { vertex_attribute_type::float1, offsetof(instance_t, rotation) },
+            { vertex_attribute_type::float4, offsetof(instance_t, color) },
+            { vertex_attribute_type::int1, offsetof(instance_t, texture_index) },
+        },
+        vertex_input_rate::instance
     };
 
     struct batch_t {
         ref<shader> _shader;
-        std::vector<quad_t> quads;
+        quad_list quads;
         const editor_camera* grid_camera = nullptr;
-        std::vector<ref<texture_2d>> textures;
-    };
 
-    struct vertex_data_t {
-        ref<vertex_buffer> vertices;
-        ref<index_buffer> indices;
+        std::vector<ref<texture_2d>> textures;
+        std::unordered_map<ref<texture_2d>, size_t> texture_slots;
+        std::optional<uint32_t> texture_capacity;
     };
 
     struct rendering_scene_t {
         std::unique_ptr<batch_t> current_batch;
-        std::vector<vertex_data_t> vertex_data;
+        std::vector<ref<vertex_buffer>> vertex_data;
         std::unordered_map<ref<render_pass>, std::vector<ref<pipeline>>> used_pipelines;
     };
 
@@ -79,23 +99,62 @@ namespace sge {
         std::unordered_map<guid, used_pipeline_data_t> data;
     };
 
+    struct vertex_ring_t {
+        ref<vertex_buffer> buffer;
+        size_t offset = 0;
+        size_t requested_size = 0;
+    };
+
     struct frame_renderer_data_t {
         std::unordered_map<ref<render_pass>, render_pass_pipeline_data_t> pipelines;
-        std::vector<vertex_data_t> vertex_data;
+
+        // batches that did not fit into the ring
+        std::vector<ref<vertex_buffer>> vertex_data;
+        vertex_ring_t vertex_ring;
     };
 
+    static constexpr size_t initial_vertex_ring_size = 4 * 1024 * 1024;
+    static constexpr size_t vertex_ring_alignment = 16;
+    static constexpr size_t max_quads_per_batch = 20000;
+    static constexpr uint32_t texture_binding = 1;
+
+    // batches at least this large have their vertices generated across the worker threads
+    static constexpr size_t parallel_quad_threshold = 8192;
+    static constexpr size_t min_quads_per_worker = 2048;
+
     struct render_pass_data_t {
         ref<render_pass> pass;
         bool active;
         glm::vec4 clear_color;
     };
 
+    struct retired_resource_t {
+        std::function<void()> callback;
+
+        // images that have not been waited on since the resource was retired
+        std::unordered_set<size_t> pending_images;
+    };
+
+    struct shader_reload_t {
+        ref<shader> _shader;
+        std::future<bool> result;
+    };
+
+#ifdef SGE_USE_VULKAN
+    static constexpr renderer_backend default_backend = renderer_backend::vulkan;
+#else
+    static constexpr renderer_backend default_backend = renderer_backend::null;
+#endif
+
     static struct {
+        renderer_backend backend = default_backend;
         std::unique_ptr<shader_library> _shader_library;
         std::unique_ptr<renderer_api> api;
         std::map<command_list_type, ref<command_queue>> queues;
 
         std::unordered_map<guid, shader_dependency_t> shader_dependencies;
+        std::vector<shader_reload_t> shader_reloads;
+        std::vector<retired_resource_t> retired_resources;
 
         std::unique_ptr<rendering_scene_t> current_scene;
         std::vector<frame_renderer_data_t> frame_renderer_data;
@@ -104,7 +163,10 @@ namespace sge {
 
         ref<uniform_buffer> camera_buffer, grid_buffer;
         ref<texture_2d> white_texture, black_texture;
+        ref<index_buffer> quad_indices;
 
+        std::unique_ptr<thread_pool> workers;
+        bool instancing = true;
         renderer::stats stats;
     } renderer_data;
 
@@ -112,13 +174,56 @@ namespace sge {
         shader_library& library = *renderer_data._shader_library;
 
         library.add("default", "assets/shaders/default.hlsl");
+        library.add("default_instanced", "assets/shaders/default_instanced.hlsl");
         library.add("grid", "assets/shaders/grid.hlsl");
     }
 
+    static void create_quad_indices() {
+        // the grid takes up one quad on top of a full batch
+        static constexpr size_t quad_count = max_quads_per_batch + 1;
+        static const std::vector<uint32_t> quad_indices = { 0, 1, 3, 1, 2, 3 };
+
+        std::vector<uint32_t> indices;
+        indices.reserve(quad_count * quad_indices.size());
+
+        for (size_t i = 0; i < quad_count; i++) {
+            uint32_t first_vertex = (uint32_t)i * 4;
+            for (uint32_t index : quad_indices) {
+                indices.push_back(first_vertex + index);
+            }
+        }
+
+        renderer_data.quad_indices = index_buffer::create(indices);
+    }
+
+    static frame_renderer_data_t& get_frame_data() {
+        swapchain& swap_chain = application::get().get_swapchain();
+        if (renderer_data.frame_renderer_data.empty()) {
+            renderer_data.frame_renderer_data.resize(swap_chain.get_image_count());
+        }
+
+        size_t current_image = swap_chain.get_current_image_index();
+        return renderer_data.frame_renderer_data[current_image];
+    }
+
+    void renderer::set_backend(renderer_backend backend) {
+        if (renderer_data.api) {
+            throw std::runtime_error("cannot switch backends while the renderer is running!");
+        }
+
+        renderer_data.backend = backend;
+    }
+
+    renderer_backend renderer::get_backend() { return renderer_data.backend; }
+
     void renderer::init() {
         {
             renderer_api* api_instance = nullptr;
 
+            if (renderer_data.backend == renderer_backend::null) {
+                api_instance = new null_renderer;
+            }
+
 #ifdef SGE_USE_VULKAN
             if (api_instance == nullptr) {
                 api_instance = new vulkan_renderer;
@@ -135,6 +240,17 @@ namespace sge {
 
         renderer_data.camera_buffer = uniform_buffer::create(sizeof(camera_data_t));
         renderer_data.grid_buffer = uniform_buffer::create(sizeof(grid_data_t));
+        create_quad_indices();
+
+        {
+            size_t thread_count = std::thread::hardware_concurrency();
+            if (thread_count > 0) {
+                // the rendering thread takes part in parallel_for
+                thread_count--;
+            }
+
+            renderer_data.workers = std::make_unique<thread_pool>(thread_count);
+        }
 
         {
             static constexpr image_format format = image_format::RGBA8_UNORM;
@@ -161,28 +277,85 @@ namespace sge {
         }
     }
 
+    static void flush_retired_resources() {
+        for (const auto& resource : renderer_data.retired_resources) {
+            resource.callback();
+        }
+
+        renderer_data.retired_resources.clear();
+    }
+
+    static void update_retired_resources(size_t current_image) {
+        auto& resources = renderer_data.retired_resources;
+        for (auto it = resources.begin(); it != resources.end();) {
+            it->pending_images.erase(current_image);
+
+            if (it->pending_images.empty()) {
+                it->callback();
+                it = resources.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    static void apply_shader_reloads() {
+        auto& reloads = renderer_data.shader_reloads;
+        for (auto it = reloads.begin(); it != reloads.end();) {
+            auto status = it->result.wait_for(std::chrono::seconds(0));
+            if (status != std::future_status::ready) {
+                it++;
+                continue;
+            }
+
+            // on failure, the old code stays live
+            if (it->result.get()) {
+                it->_shader->apply_recompiled();
+            }
+
+            it = reloads.erase(it);
+        }
+    }
+
     void renderer::shutdown() {
         if (!renderer_data.render_passes.empty()) {
             throw std::runtime_error("not all render passes have been popped!");
         }
+        renderer_data.shader_reloads.clear();
         renderer_data.frame_renderer_data.clear();
+        flush_retired_resources();
         renderer_data._shader_library.reset();
         renderer_data.queues.clear();
+        renderer_data.workers.reset();
 
         renderer_data.api->shutdown();
         renderer_data.api.reset();
     }
 
     void renderer::new_frame() {
+        swapchain& swap_chain = application::get().get_swapchain();
+        size_t current_image = swap_chain.get_current_image_index();
+
+        update_retired_resources(current_image);
+        apply_shader_reloads();
+
         if (renderer_data.frame_renderer_data.empty()) {
             return;
         }
 
-        swapchain& swap_chain = application::get().get_swapchain();
-        size_t current_image = swap_chain.get_current_image_index();
         auto& frame_data = renderer_data.frame_renderer_data[current_image];
         frame_data.vertex_data.clear();
 
+        // the swapchain has waited on this image's fence, so the gpu is done reading the ring
+        auto& ring = frame_data.vertex_ring;
+        ring.offset = 0;
+        if (ring.buffer && ring.requested_size > ring.buffer->get_total_size()) {
+            spdlog::info("growing vertex ring of image {0} to {1} bytes", current_image,
+                         ring.requested_size);
+
+            ring.buffer = vertex_buffer::create(ring.requested_size);
+        }
+
         for (auto& [renderpass, pipelines] : frame_data.pipelines) {
             for (auto& [_shader, data] : pipelines.data) {
                 for (const auto& _pipeline : data.currently_using) {
@@ -197,14 +370,24 @@ namespace sge {
 
     void renderer::wait() { renderer_data.api->wait(); }
 
+    bool renderer::load_pipeline_cache(const fs::path& path) {
+        return renderer_data.api->load_pipeline_cache(path);
+    }
+
+    bool renderer::save_pipeline_cache(const fs::path& path) {
+        return renderer_data.api->save_pipeline_cache(path);
+    }
+
     void renderer::clear_render_data() {
         wait();
 
         renderer_data.frame_renderer_data.clear();
+        flush_retired_resources();
         renderer_data.shader_dependencies.clear();
 
         renderer_data.black_texture.reset();
         renderer_data.white_texture.reset();
+        renderer_data.quad_indices.reset();
         renderer_data.grid_buffer.reset();
         renderer_data.camera_buffer.reset();
     }
@@ -243,6 +426,41 @@ namespace sge {
         }
     }
 
+    void renderer::reload_shader(ref<shader> _shader) {
+        for (const auto& reload : renderer_data.shader_reloads) {
+            if (reload._shader->id == _shader->id) {
+                return;
+            }
+        }
+
+        // ref counts are not atomic, so the worker only gets the raw pointer. the reload entry
+        // keeps the shader alive until the compile has finished
+        shader* instance = _shader.raw();
+
+        shader_reload_t reload;
+        reload._shader = _shader;
+        reload.result =
+            std::async(std::launch::async, [instance]() { return instance->recompile(); });
+
+        renderer_data.shader_reloads.push_back(std::move(reload));
+    }
+
+    void renderer::retire(const std::function<void()>& callback) {
+        // nothing can be in flight without frame data
+        if (renderer_data.frame_renderer_data.empty()) {
+            callback();
+            return;
+        }
+
+        retired_resource_t resource;
+        resource.callback = callback;
+        for (size_t i = 0; i < renderer_data.frame_renderer_data.size(); i++) {
+            resource.pending_images.insert(i);
+        }
+
+        renderer_data.retired_resources.push_back(resource);
+    }
+
     ref<texture_2d> renderer::get_white_texture() { return renderer_data.white_texture; }
     ref<texture_2d> renderer::get_black_texture() { return renderer_data.black_texture; }
 
@@ -282,15 +500,7 @@ namespace sge {
 
         flush_batch();
 
-        auto& app = application::get();
-        swapchain& swap_chain = app.get_swapchain();
-
-        if (renderer_data.frame_renderer_data.empty()) {
-            renderer_data.frame_renderer_data.resize(swap_chain.get_image_count());
-        }
-
-        size_t current_image = swap_chain.get_current_image_index();
-        auto& frame_renderer_data = renderer_data.frame_renderer_data[current_image];
+        auto& frame_renderer_data = get_frame_data();
         frame_renderer_data.vertex_data.insert(frame_renderer_data.vertex_data.end(),
                                                scene->vertex_data.begin(),
                                                scene->vertex_data.end());
@@ -330,7 +540,106 @@ namespace sge {
         begin_batch();
     }
 
+    static void write_grid_vertices(quad_vertex* vertices) {
+        quad_vertex v;
+        v.color = glm::vec4(1.f);
+        v.texture_index = -1;
+
+        // top right
+        v.position = glm::vec2(1.f, 1.f);
+        v.uv = glm::vec2(1.f, 0.f);
+        vertices[0] = v;
+
+        // bottom right
+        v.position = glm::vec2(1.f, -1.f);
+        v.uv = glm::vec2(1.f, 1.f);
+        vertices[1] = v;
+
+        // bottom left
+        v.position = glm::vec2(-1.f, -1.f);
+        v.uv = glm::vec2(0.f, 1.f);
+        vertices[2] = v;
+
+        // top left
+        v.position = glm::vec2(-1.f, 1.f);
+        v.uv = glm::vec2(0.f, 0.f);
+        vertices[3] = v;
+    }
+
+    static ref<pipeline> get_pipeline(frame_renderer_data_t& frame_data, ref<render_pass> pass,
+                                      ref<shader> _shader, const pipeline_input_layout& layout) {
+        ref<pipeline> _pipeline;
+
+        guid id = _shader->id;
+        auto& pass_pipelines = frame_data.pipelines[pass].data;
+        if (pass_pipelines.find(id) != pass_pipelines.end()) {
+            auto& queue = pass_pipelines[id].used;
+            if (!queue.empty()) {
+                _pipeline = queue.front();
+                queue.pop();
+            }
+        }
+
+        if (!_pipeline) {
+            pipeline_spec spec;
+            spec._shader = _shader;
+            spec.renderpass = pass;
+            spec.input_layout = layout;
+
+            _pipeline = pipeline::create(spec);
+            _pipeline->set_uniform_buffer(renderer_data.camera_buffer, 0);
+        }
+
+        return _pipeline;
+    }
+
+    // returns where to write size bytes of vertex data for the current batch
+    static void* alloc_vertex_data(vertex_ring_t& ring, size_t size,
+                                   std::vector<uint8_t>& overflow_data) {
+        if (!ring.buffer) {
+            ring.buffer = vertex_buffer::create(initial_vertex_ring_size);
+        }
+
+        // if the batch doesn't fit, fall back to a one-off buffer and grow the ring the next
+        // time this image comes around
+        if (ring.offset + size > ring.buffer->get_total_size()) {
+            overflow_data.resize(size);
+
+            size_t required_size = (ring.offset + size) * 2;
+            ring.requested_size = std::max(ring.requested_size, required_size);
+            renderer_data.stats.vertex_ring_overflows++;
+
+            return overflow_data.data();
+        }
+
+        return (void*)((size_t)ring.buffer->get_mapped_data() + ring.offset);
+    }
+
+    static void commit_vertex_data(vertex_ring_t& ring, size_t size, size_t stride,
+                                   const std::vector<uint8_t>& overflow_data, draw_data& data) {
+        size_t ring_size = ring.buffer->get_total_size();
+
+        if (!overflow_data.empty()) {
+            data.vertices = vertex_buffer::create(overflow_data.data(), stride, size / stride);
+            renderer_data.current_scene->vertex_data.push_back(data.vertices);
+        } else {
+            ring.buffer->flush(ring.offset, size);
+
+            data.vertices = ring.buffer;
+            data.vertex_offset = ring.offset;
+
+            size_t end = ring.offset + size;
+            ring.offset = (end + vertex_ring_alignment - 1) & ~(vertex_ring_alignment - 1);
+            ring.offset = std::min(ring.offset, ring_size);
+        }
+
+        renderer_data.stats.vertex_ring_used = ring.offset;
+        renderer_data.stats.vertex_ring_capacity = ring_size;
+    }
+
     void renderer::flush_batch() {
+        profiler_scope scope("batch_flush");
+
         auto& scene = *renderer_data.current_scene;
         auto& batch = scene.current_batch;
         if (!batch) {
@@ -345,159 +654,102 @@ namespace sge {
                 throw std::runtime_error("cannot add commands to an empty command list!");
             }
 
-            ref<pipeline> _pipeline;
-            if (!renderer_data.frame_renderer_data.empty()) {
-                swapchain& swap_chain = application::get().get_swapchain();
-                size_t image_index = swap_chain.get_current_image_index();
-                auto& frame_data = renderer_data.frame_renderer_data[image_index];
-
-                guid id = batch->_shader->id;
-                if (frame_data.pipelines[pass].data.find(id) !=
-                    frame_data.pipelines[pass].data.end()) {
-                    auto& queue = frame_data.pipelines[pass].data[id].used;
-                    if (!queue.empty()) {
-                        _pipeline = queue.front();
-                        queue.pop();
-                    }
+            auto& frame_data = get_frame_data();
+            auto& ring = frame_data.vertex_ring;
+
+            // only the default shader has an instanced counterpart
+            bool instanced = renderer_data.instancing && batch->grid_camera == nullptr &&
+                             batch->_shader == renderer_data._shader_library->get("default");
+
+            draw_data data;
+            data.cmdlist = renderer_data.cmdlist;
+            data.indices = renderer_data.quad_indices;
+
+            std::vector<uint8_t> overflow_data;
+            if (instanced) {
+                auto _shader = renderer_data._shader_library->get("default_instanced");
+                data._pipeline = get_pipeline(frame_data, pass, _shader, instance_layout);
+
+                size_t instance_count = batch->quads.size();
+                size_t data_size = instance_count * sizeof(instance_t);
+                auto instances = (instance_t*)alloc_vertex_data(ring, data_size, overflow_data);
+
+                const auto& quads = batch->quads;
+                for (size_t i = 0; i < instance_count; i++) {
+                    auto& instance = instances[i];
+
+                    instance.position = glm::vec2(quads.x[i], quads.y[i]);
+                    instance.size = glm::vec2(quads.width[i], quads.height[i]);
+                    instance.rotation = quads.rotation[i];
+                    instance.color = quads.color[i];
+                    instance.texture_index = quads.texture_index[i];
                 }
-            }
-            if (!_pipeline) {
-                pipeline_spec spec;
-                spec._shader = batch->_shader;
-                spec.renderpass = pass;
-                spec.input_layout.stride = sizeof(vertex);
-                spec.input_layout.attributes = {
-                    { vertex_attribute_type::float2, offsetof(vertex, position) },
-                    { vertex_attribute_type::float4, offsetof(vertex, color) },
-                    { vertex_attribute_type::float2, offsetof(vertex, uv) },
-                    { vertex_attribute_type::int1, offsetof(vertex, texture_index) }
-                };
-
-                _pipeline = pipeline::create(spec);
-                _pipeline->set_uniform_buffer(renderer_data.camera_buffer, 0);
-            }
 
-            std::vector<vertex> vertices;
-            std::vector<uint32_t> indices;
+                commit_vertex_data(ring, data_size, sizeof(instance_t), overflow_data, data);
+                data.index_count = 6;
+                data.instance_count = (uint32_t)instance_count;
+
+                renderer_data.stats.instance_count += instance_count;
+                renderer_data.stats.index_count += data.index_count;
+            } else {
+                data._pipeline = get_pipeline(frame_data, pass, batch->_shader, vertex_layout);
 
-            auto add_quad_indices = [&]() {
-                std::vector<uint32_t> quad_indices = { 0, 1, 3, 1, 2, 3 };
-                for (uint32_t& index : quad_indices) {
-                    index += (uint32_t)vertices.size();
+                size_t quad_count = batch->quads.size();
+                if (batch->grid_camera != nullptr) {
+                    quad_count++;
+                }
+
+                size_t vertex_count = quad_count * 4;
+                size_t data_size = vertex_count * sizeof(quad_vertex);
+                auto vertices = (quad_vertex*)alloc_vertex_data(ring, data_size, overflow_data);
+
+                size_t vertex_index = 0;
+                if (batch->grid_camera != nullptr) {
+                    grid_data_t grid_data;
+                    grid_data.view_size = batch->grid_camera->get_view_size();
+                    grid_data.aspect_ratio = batch->grid_camera->get_aspect_ratio();
+                    grid_data.camera_position = batch->grid_camera->get_position();
+                    grid_data.viewport_size.x = batch->grid_camera->get_viewport_width();
+                    grid_data.viewport_size.y = batch->grid_camera->get_viewport_height();
+
+                    renderer_data.grid_buffer->set_data(grid_data);
+                    data._pipeline->set_uniform_buffer(renderer_data.grid_buffer, 0);
+
+                    write_grid_vertices(&vertices[vertex_index]);
+                    vertex_index += 4;
+                }
+
+                const auto& quads = batch->quads;
+                auto quad_vertices = &vertices[vertex_index];
+                if (quads.size() >= parallel_quad_threshold) {
+                    renderer_data.workers->parallel_for(
+                        quads.size(), min_quads_per_worker, [&](size_t begin, size_t end) {
+                            quad_kernel::generate_vertices(quads, begin, end, quad_vertices);
+                        });
+                } else {
+                    quad_kernel::generate_vertices(quads, 0, quads.size(), quad_vertices);
                 }
-                indices.insert(indices.end(), quad_indices.begin(), quad_indices.end());
-            };
-
-            if (batch->grid_camera != nullptr) {
-                grid_data_t grid_data;
-                grid_data.view_size = batch->grid_camera->get_view_size();
-                grid_data.aspect_ratio = batch->grid_camera->get_aspect_ratio();
-                grid_data.camera_position = batch->grid_camera->get_position();
-                grid_data.viewport_size.x = batch->grid_camera->get_viewport_width();
-                grid_data.viewport_size.y = batch->grid_camera->get_viewport_height();
-
-                renderer_data.grid_buffer->set_data(grid_data);
-                _pipeline->set_uniform_buffer(renderer_data.grid_buffer, 0);
-
-                add_quad_indices();
-
-                vertex v;
-                v.color = glm::vec4(1.f);
-                v.texture_index = -1;
-
-                // top right
-                v.position = glm::vec2(1.f, 1.f);
-                v.uv = glm::vec2(1.f, 0.f);
-                vertices.push_back(v);
-
-                // bottom right
-                v.position = glm::vec2(1.f, -1.f);
-                v.uv = glm::vec2(1.f, 1.f);
-                vertices.push_back(v);
-
-                // bottom left
-                v.position = glm::vec2(-1.f, -1.f);
-                v.uv = glm::vec2(0.f, 1.f);
-                vertices.push_back(v);
-
-                // top left
-                v.position = glm::vec2(-1.f, 1.f);
-                v.uv = glm::vec2(0.f, 0.f);
-                vertices.push_back(v);
-            }
 
-            for (const auto& quad : batch->quads) {
-                add_quad_indices();
-
-                auto rot_rad = glm::radians(quad.rotation);
-                auto cos_rot = glm::cos(rot_rad);
-                auto sin_rot = glm::sin(rot_rad);
-
-                glm::vec2 half_size = quad.size / 2.f;
-
-                // top right
-                auto v = &vertices.emplace_back();
-                v->position.x = half_size.x * cos_rot - half_size.y * sin_rot;
-                v->position.y = half_size.x * sin_rot + half_size.y * cos_rot;
-                v->position = quad.position + v->position;
-                v->color = quad.color;
-                v->uv = glm::vec2(1.f, 0.f);
-                v->texture_index = (int32_t)quad.texture_index;
-
-                // bottom right
-                v = &vertices.emplace_back();
-                v->position.x = half_size.x * cos_rot - -half_size.y * sin_rot;
-                v->position.y = half_size.x * sin_rot + -half_size.y * cos_rot;
-                v->position = quad.position + v->position;
-                v->color = quad.color;
-                v->uv = glm::vec2(1.f, 1.f);
-                v->texture_index = (int32_t)quad.texture_index;
-
-                // bottom left
-                v = &vertices.emplace_back();
-                v->position.x = -half_size.x * cos_rot - -half_size.y * sin_rot;
-                v->position.y = -half_size.x * sin_rot + -half_size.y * cos_rot;
-                v->position = quad.position + v->position;
-                v->color = quad.color;
-                v->uv = glm::vec2(0.f, 1.f);
-                v->texture_index = (int32_t)quad.texture_index;
-
-                // top left
-                v = &vertices.emplace_back();
-                v->position.x = -half_size.x * cos_rot - half_size.y * sin_rot;
-                v->position.y = -half_size.x * sin_rot + half_size.y * cos_rot;
-                v->position = quad.position + v->position;
-                v->color = quad.color;
-                v->uv = glm::vec2(0.f, 0.f);
-                v->texture_index = (int32_t)quad.texture_index;
+                commit_vertex_data(ring, data_size, sizeof(quad_vertex), overflow_data, data);
+                data.index_count = (uint32_t)(quad_count * 6);
+
+                renderer_data.stats.vertex_count += vertex_count;
+                renderer_data.stats.index_count += data.index_count;
             }
 
             for (size_t i = 0; i < batch->textures.size(); i++) {
-                // gonna have to assume 1
-                _pipeline->set_texture(batch->textures[i], 1, i);
+                data._pipeline->set_texture(batch->textures[i], texture_binding, i);
             }
 
-            draw_data data;
-            data.cmdlist = renderer_data.cmdlist;
-            data.vertices = vertex_buffer::create(vertices);
-            data.indices = index_buffer::create(indices);
-            data._pipeline = _pipeline;
             renderer_data.api->submit(data);
 
-            vertex_data_t vertex_data;
-            vertex_data.vertices = data.vertices;
-            vertex_data.indices = data.indices;
-            scene.vertex_data.push_back(vertex_data);
-
             if (scene.used_pipelines.find(pass) == scene.used_pipelines.end()) {
                 scene.used_pipelines.insert(std::make_pair(pass, std::vector<ref<pipeline>>()));
             }
-            scene.used_pipelines[pass].push_back(_pipeline);
+            scene.used_pipelines[pass].push_back(data._pipeline);
 
             renderer_data.stats.draw_calls++;
             renderer_data.stats.quad_count += batch->quads.size();
-            renderer_data.stats.vertex_count += vertices.size();
-            renderer_data.stats.index_count += indices.size();
         }
 
         batch.reset();
@@ -538,23 +790,52 @@ namespace sge {
         }
     }
 
+    // flushes the current batch and starts a new one with the same shader
+    static void split_batch() {
+        auto& scene = *renderer_data.current_scene;
+        auto _shader = scene.current_batch->_shader;
+
+        renderer::next_batch();
+        scene.current_batch->_shader = _shader;
+    }
+
     size_t renderer::push_texture(ref<texture_2d> texture) {
-        auto& batch = *renderer_data.current_scene->current_batch;
+        auto batch = renderer_data.current_scene->current_batch.get();
 
-        std::optional<size_t> texture_index;
-        for (size_t i = 0; i < batch.textures.size(); i++) {
-            if (batch.textures[i] == texture) {
-                texture_index = i;
-            }
+        auto it = batch->texture_slots.find(texture);
+        if (it != batch->texture_slots.end()) {
+            return it->second;
         }
 
-        if (texture_index.has_value()) {
-            return texture_index.value();
-        } else {
-            size_t index = batch.textures.size();
-            batch.textures.push_back(texture);
-            return index;
+        if (!batch->texture_capacity.has_value()) {
+            batch->texture_capacity = batch->_shader->get_texture_capacity(texture_binding);
         }
+
+        // roll over to a new batch once the shader's texture array is full
+        uint32_t capacity = batch->texture_capacity.value();
+        if (capacity > 0 && batch->textures.size() >= capacity) {
+            split_batch();
+            batch = renderer_data.current_scene->current_batch.get();
+            batch->texture_capacity = capacity;
+        }
+
+        size_t index = batch->textures.size();
+        batch->textures.push_back(texture);
+        batch->texture_slots.insert(std::make_pair(texture, index));
+
+        return index;
+    }
+
+    static void add_quad(glm::vec2 position, glm::vec2 size, float rotation,
+                         const glm::vec4& color, ref<texture_2d> texture) {
+        auto& scene = *renderer_data.current_scene;
+        if (scene.current_batch->quads.size() >= max_quads_per_batch) {
+            split_batch();
+        }
+
+        // this may also split the batch
+        int32_t texture_index = (int32_t)renderer::push_texture(texture);
+        scene.current_batch->quads.push_back(position, size, rotation, color, texture_index);
     }
 
     void renderer::draw_grid(const editor_camera& camera) {
@@ -568,60 +849,27 @@ namespace sge {
     }
 
     void renderer::draw_quad(glm::vec2 position, glm::vec2 size, glm::vec4 color) {
-        auto& batch = *renderer_data.current_scene->current_batch;
-
-        quad_t quad;
-        quad.position = position;
-        quad.size = size;
-        quad.rotation = 0.f;
-        quad.color = color;
-        quad.texture_index = push_texture(renderer_data.white_texture);
-
-        batch.quads.push_back(quad);
+        add_quad(position, size, 0.f, color, renderer_data.white_texture);
     }
 
     void renderer::draw_quad(glm::vec2 position, glm::vec2 size, glm::vec4 color,
                              ref<texture_2d> texture) {
-        auto& batch = *renderer_data.current_scene->current_batch;
-
-        quad_t quad;
-        quad.position = position;
-        quad.size = size;
-        quad.rotation = 0.f;
-        quad.color = color;
-        quad.texture_index = push_texture(texture);
-
-        batch.quads.push_back(quad);
+        add_quad(position, size, 0.f, color, texture);
     }
 
     void renderer::draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
                                      glm::vec4 color) {
-        auto& batch = *renderer_data.current_scene->current_batch;
-
-        quad_t quad;
-        quad.position = position;
-        quad.size = size;
-        quad.rotation = rotation;
-        quad.color = color;
-        quad.texture_index = push_texture(renderer_data.white_texture);
-
-        batch.quads.push_back(quad);
+        add_quad(position, size, rotation, color, renderer_data.white_texture);
     }
 
     void renderer::draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
                                      glm::vec4 color, ref<texture_2d> texture) {
-        auto& batch = *renderer_data.current_scene->current_batch;
-
-        quad_t quad;
-        quad.position = position;
-        quad.size = size;
-        quad.rotation = rotation;
-        quad.color = color;
-        quad.texture_index = push_texture(texture);
-
-        batch.quads.push_back(quad);
+        add_quad(position, size, rotation, color, texture);
     }
 
+    void renderer::set_instancing_enabled(bool enabled) { renderer_data.instancing = enabled; }
+    bool renderer::is_instancing_enabled() { return renderer_data.instancing; }
+
     renderer::stats renderer::get_stats() { return renderer_data.stats; }
     device_info renderer::query_device_info() { return renderer_data.api->query_device_info(); }
 } // namespace sge
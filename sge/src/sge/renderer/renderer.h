@@ -30,8 +30,17 @@ namespace sge {
         ref<vertex_buffer> vertices;
         ref<index_buffer> indices;
         ref<pipeline> _pipeline;
+
+        // byte offset into the vertex buffer
+        size_t vertex_offset = 0;
+
+        // if 0, the entire index buffer is drawn
+        uint32_t index_count = 0;
+        uint32_t instance_count = 1;
     };
 
+    enum class renderer_backend { vulkan, null };
+
     struct device_info {
         std::string name;
         std::string graphics_api;
@@ -47,6 +56,9 @@ namespace sge {
 
         virtual void submit(const draw_data& data) = 0;
 
+        virtual bool load_pipeline_cache(const fs::path& path) = 0;
+        virtual bool save_pipeline_cache(const fs::path& path) = 0;
+
         virtual device_info query_device_info() = 0;
     };
 
@@ -54,6 +66,10 @@ namespace sge {
     public:
         renderer() = delete;
 
+        // must be called before init
+        static void set_backend(renderer_backend backend);
+        static renderer_backend get_backend();
+
         static void init();
         static void shutdown();
         static void new_frame();
@@ -61,10 +77,20 @@ namespace sge {
 
         static void clear_render_data();
 
+        // driver pipeline cache, persisted between runs
+        static bool load_pipeline_cache(const fs::path& path);
+        static bool save_pipeline_cache(const fs::path& path);
+
         static void add_shader_dependency(guid shader_guid, pipeline* _pipeline);
         static void remove_shader_dependency(guid shader_guid, pipeline* _pipeline);
         static void on_shader_reloaded(guid shader_guid);
 
+        // compiles on a worker thread; the result is swapped in at the start of a later frame
+        static void reload_shader(ref<shader> _shader);
+
+        // runs the callback once no frame in flight can still be using what it frees
+        static void retire(const std::function<void()>& callback);
+
         static ref<texture_2d> get_white_texture();
         static ref<texture_2d> get_black_texture();
 
@@ -100,12 +126,22 @@ namespace sge {
         static void draw_rotated_quad(glm::vec2 position, float rotation, glm::vec2 size,
                                       glm::vec4 color, ref<texture_2d> texture);
 
+        // When enabled, batches using the default shader upload one record per quad and expand
+        // the corners on the gpu instead of generating four vertices per quad on the cpu.
+        static void set_instancing_enabled(bool enabled);
+        static bool is_instancing_enabled();
+
         struct stats {
             uint32_t draw_calls;
             uint32_t quad_count;
 
             uint32_t vertex_count;
             uint32_t index_count;
+            uint32_t instance_count;
+
+            size_t vertex_ring_used;
+            size_t vertex_ring_capacity;
+            uint32_t vertex_ring_overflows;
 
             void reset() {
                 draw_calls = 0;
@@ -113,6 +149,11 @@ namespace sge {
 
                 vertex_count = 0;
                 index_count = 0;
+                instance_count = 0;
+
+                vertex_ring_used = 0;
+                vertex_ring_capacity = 0;
+                vertex_ring_overflows = 0;
             }
         };
         static stats get_stats();
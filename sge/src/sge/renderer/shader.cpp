@@ -16,6 +16,8 @@
 
 #include "sgepch.h"
 #include "sge/renderer/shader.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_shader.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_shader.h"
@@ -66,6 +68,10 @@ namespace sge {
     ref<shader> shader::create(const fs::path& path, shader_language language) {
         fs::path filepath = fs::absolute(path);
 
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_shader>::create(filepath, language);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_shader>::create(filepath, language);
 #endif
@@ -94,6 +100,12 @@ namespace sge {
         }
     }
 
+    void shader_library::reload_all_async() {
+        for (const auto& [name, _shader] : m_library) {
+            renderer::reload_shader(_shader);
+        }
+    }
+
     bool shader_library::add(const std::string& name, ref<shader> _shader) {
         if (m_library.find(name) != m_library.end()) {
             return false;
@@ -29,6 +29,17 @@ namespace sge {
 
         virtual asset_type get_asset_type() override { return asset_type::shader; }
 
+        // The number of textures that can be bound to the given binding of set 0, as declared
+        // in the shader source. 0 if nothing is bound there.
+        virtual uint32_t get_texture_capacity(uint32_t binding) = 0;
+
+        // Compiles the source without touching the live shader. Safe to call from a worker
+        // thread; returns false and keeps the current code if compilation fails.
+        virtual bool recompile() = 0;
+
+        // Swaps in the result of the last successful recompile, if there is one.
+        virtual void apply_recompiled() = 0;
+
     protected:
         static void parse_source(const fs::path& path,
                                  std::map<shader_stage, std::string>& output_source);
@@ -42,6 +53,7 @@ namespace sge {
         shader_library& operator=(const shader_library&) = delete;
 
         void reload_all();
+        void reload_all_async();
 
         bool add(const std::string& name, ref<shader> _shader);
         ref<shader> add(const std::string& name, const fs::path& path);
@@ -16,6 +16,8 @@
 
 #include "sgepch.h"
 #include "sge/renderer/swapchain.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_swapchain.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_swapchain.h"
@@ -24,6 +26,10 @@ namespace sge {
     std::unique_ptr<swapchain> swapchain::create(ref<window> _window) {
         swapchain* instance = nullptr;
 
+        if (renderer::get_backend() == renderer_backend::null) {
+            instance = new null_swapchain(_window);
+        }
+
 #ifdef SGE_USE_VULKAN
         if (instance == nullptr) {
             instance = new vulkan_swapchain(_window);
@@ -17,6 +17,8 @@
 #include "sgepch.h"
 #include "sge/renderer/texture.h"
 #include "sge/asset/json.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_texture.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_texture.h"
@@ -29,6 +31,10 @@ namespace sge {
             throw std::runtime_error("cannot create a texture from the passed image!");
         }
 
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_texture_2d>::create(spec);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_texture_2d>::create(spec);
 #endif
@@ -16,12 +16,18 @@
 
 #include "sgepch.h"
 #include "sge/renderer/uniform_buffer.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_buffer.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_uniform_buffer.h"
 #endif
 namespace sge {
     ref<uniform_buffer> uniform_buffer::create(size_t size) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_uniform_buffer>::create(size);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_uniform_buffer>::create(size);
 #endif
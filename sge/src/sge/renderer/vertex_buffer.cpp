@@ -16,16 +16,34 @@
 
 #include "sgepch.h"
 #include "sge/renderer/vertex_buffer.h"
+#include "sge/renderer/renderer.h"
+#include "sge/platform/null/null_buffer.h"
 #ifdef SGE_USE_VULKAN
 #include "sge/platform/vulkan/vulkan_base.h"
 #include "sge/platform/vulkan/vulkan_vertex_buffer.h"
 #endif
 namespace sge {
     ref<vertex_buffer> vertex_buffer::create(const void* data, size_t stride, size_t count) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_vertex_buffer>::create(data, stride, count);
+        }
+
 #ifdef SGE_USE_VULKAN
         return ref<vulkan_vertex_buffer>::create(data, stride, count);
 #endif
 
         return nullptr;
     }
+
+    ref<vertex_buffer> vertex_buffer::create(size_t size) {
+        if (renderer::get_backend() == renderer_backend::null) {
+            return ref<null_vertex_buffer>::create(size);
+        }
+
+#ifdef SGE_USE_VULKAN
+        return ref<vulkan_vertex_buffer>::create(size);
+#endif
+
+        return nullptr;
+    }
 } // namespace sge
\ No newline at end of file
@@ -23,10 +23,18 @@ namespace sge {
         }
         static ref<vertex_buffer> create(const void* data, size_t stride, size_t count);
 
+        // Creates a host-visible buffer of size bytes that stays mapped for its entire lifetime.
+        // Written data must be flushed before it is drawn.
+        static ref<vertex_buffer> create(size_t size);
+
         virtual ~vertex_buffer() = default;
 
         virtual size_t get_vertex_stride() = 0;
         virtual size_t get_vertex_count() = 0;
         size_t get_total_size() { return get_vertex_count() * get_vertex_stride(); }
+
+        // only valid for buffers created with create(size)
+        virtual void* get_mapped_data() = 0;
+        virtual void flush(size_t offset, size_t size) = 0;
     };
 } // namespace sge
\ No newline at end of file
@@ -127,11 +127,16 @@ namespace sge {
 
             instance = object_ref::from_object(object);
         }
+
+        if (_class != nullptr && (methods == nullptr || methods->_class != _class)) {
+            methods = &script_engine::get_script_methods(_class);
+        }
     }
 
     void script_component::remove_script() {
         if (_class != nullptr) {
             instance.reset();
+            methods = nullptr;
             _class = nullptr;
         }
     }
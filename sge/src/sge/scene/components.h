@@ -237,6 +237,8 @@ namespace sge {
         }
     };
 
+    struct script_methods_t;
+
     struct script_component {
         script_component() = default;
 
@@ -248,6 +250,9 @@ namespace sge {
         std::string class_name;
         bool enabled = true;
 
+        // resolved by verify_script for the current class
+        const script_methods_t* methods = nullptr;
+
         void verify_script(entity e);
         void remove_script();
 
@@ -262,22 +267,6 @@ namespace sge {
     };
 
     //=== scene::on_component_added/on_component_removed ====
-    template <>
-    inline void scene::on_component_added<transform_component>(const entity& e,
-                                                               transform_component& component) {
-        if (e.has_all<sprite_renderer_component>()) {
-            recalculate_render_order();
-        }
-    }
-
-    template <>
-    inline void scene::on_component_added<sprite_renderer_component>(
-        const entity& e, sprite_renderer_component& component) {
-        if (e.has_all<transform_component>()) {
-            recalculate_render_order();
-        }
-    }
-
     template <>
     inline void scene::on_component_added<camera_component>(const entity& e,
                                                             camera_component& component) {
@@ -287,22 +276,6 @@ namespace sge {
         component.camera.set_render_target_size(width, height);
     }
 
-    template <>
-    inline void scene::on_component_removed<transform_component>(const entity& e,
-        transform_component& component) {
-        if (e.has_all<sprite_renderer_component>()) {
-            recalculate_render_order();
-        }
-    }
-    
-    template <>
-    inline void scene::on_component_removed<sprite_renderer_component>(
-        const entity& e, sprite_renderer_component& component) {
-        if (e.has_all<transform_component>()) {
-            recalculate_render_order();
-        }
-    }
-
     template <>
     inline void scene::on_component_removed<native_script_component>(
         const entity& e, native_script_component& component) {
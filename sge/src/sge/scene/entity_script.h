@@ -27,9 +27,11 @@ namespace sge {
         virtual void on_detach() {}
 
         virtual void on_update(timestep ts) {}
+        virtual void on_fixed_update(timestep ts) {}
         virtual void on_event(event& e) {}
 
         virtual void on_collision(entity other) {}
+        virtual void on_collision_end(entity other) {}
 
     protected:
         template <typename T, typename... Args>
@@ -57,6 +59,10 @@ namespace sge {
             m_parent.remove_component<T>();
         }
 
+        // transform, rigid body and collider changes made in place through get_component don't
+        // reach box2d on their own; without this, the next physics step overwrites them
+        void mark_physics_dirty() { m_parent.get_scene()->update_physics_data(m_parent); }
+
         entity m_parent;
         friend struct native_script_component;
     };
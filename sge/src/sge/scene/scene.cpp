@@ -17,6 +17,7 @@
 #include "sgepch.h"
 #include "sge/core/application.h"
 #include "sge/core/window.h"
+#include "sge/core/profiler.h"
 #include "sge/renderer/renderer.h"
 #include "sge/scene/entity.h"
 #include "sge/scene/components.h"
@@ -36,16 +37,40 @@ namespace sge {
         box,
     };
 
-    struct entity_physics_data {
+    // internal component holding an entity's box2d handles. it is not registered with entt::meta,
+    // so it is never copied or serialized along with the scene
+    struct physics_handle {
+        b2Body* body = nullptr;
+        b2Fixture* fixture = nullptr;
+
+        // transform before the last step, for interpolation
+        glm::vec2 previous_translation;
+        float previous_rotation;
+
         std::optional<collider_type> _collider_type;
         std::optional<glm::vec2> current_box_size;
+    };
 
-        b2Fixture* fixture;
-        b2Body* body;
+    struct contact_event_t {
+        entt::entity receiver, other;
+        bool begin;
     };
 
     struct scene_physics_data {
-        std::unordered_map<entt::entity, entity_physics_data> bodies;
+        // recorded during a step and dispatched after it. the second buffer is swapped in while
+        // dispatching, because callbacks that destroy fixtures report contacts as well
+        std::vector<contact_event_t> contacts, dispatched_contacts;
+
+        // entities whose physics state must be pushed to box2d before the next step
+        std::vector<entt::entity> dirty;
+
+        // bodies of removed handles; the world may be locked when they are removed
+        std::vector<b2Body*> destroyed_bodies;
+
+        // simulated time that has not been stepped yet, and how far rendering is between the
+        // last two steps
+        double accumulator = 0.0;
+        float interpolation_alpha = 1.f;
 
         b2World* world;
         std::unique_ptr<b2ContactListener> listener;
@@ -58,69 +83,137 @@ namespace sge {
             return std::unique_ptr<b2ContactListener>(instance);
         }
 
-        virtual void BeginContact(b2Contact* contact) override {
-            b2Fixture* fixture = contact->GetFixtureA();
-            uintptr_t user_data = fixture->GetUserData().pointer;
-            entity entity_a((entt::entity)(uint32_t)user_data, m_scene);
+        // contacts are only recorded here; scripts run once the step has finished
+        virtual void BeginContact(b2Contact* contact) override { record(contact, true); }
+        virtual void EndContact(b2Contact* contact) override { record(contact, false); }
 
-            fixture = contact->GetFixtureB();
-            user_data = fixture->GetUserData().pointer;
-            entity entity_b((entt::entity)(uint32_t)user_data, m_scene);
+    private:
+        scene_contact_listener(scene* _scene) { m_scene = _scene; }
 
-            // native scripts
-            if (entity_a.has_all<native_script_component>()) {
-                auto& nsc = entity_a.get_component<native_script_component>();
-                if (nsc.script != nullptr) {
-                    nsc.script->on_collision(entity_b);
-                }
+        void record(b2Contact* contact, bool begin) {
+            uintptr_t user_data = contact->GetFixtureA()->GetUserData().pointer;
+            auto entity_a = (entt::entity)(uint32_t)user_data;
+
+            user_data = contact->GetFixtureB()->GetUserData().pointer;
+            auto entity_b = (entt::entity)(uint32_t)user_data;
+
+            auto& contacts = m_scene->m_physics_data->contacts;
+            contacts.push_back({ entity_a, entity_b, begin });
+            contacts.push_back({ entity_b, entity_a, begin });
+        }
+
+        scene* m_scene;
+    };
+
+    static entt::entity get_fixture_entity(b2Fixture* fixture) {
+        return (entt::entity)(uint32_t)fixture->GetUserData().pointer;
+    }
+
+    class scene_raycast_callback : public b2RayCastCallback {
+    public:
+        scene_raycast_callback(raycast_hit* hits, size_t capacity, uint16_t mask) {
+            m_hits = hits;
+            m_capacity = capacity;
+            m_mask = mask;
+            m_count = 0;
+        }
+
+        virtual float ReportFixture(b2Fixture* fixture, const b2Vec2& point,
+                                    const b2Vec2& normal, float fraction) override {
+            if ((fixture->GetFilterData().categoryBits & m_mask) == 0) {
+                return -1.f;
             }
 
-            if (entity_b.has_all<native_script_component>()) {
-                auto& nsc = entity_b.get_component<native_script_component>();
-                if (nsc.script != nullptr) {
-                    nsc.script->on_collision(entity_a);
+            raycast_hit hit;
+            hit.id = get_fixture_entity(fixture);
+            hit.point = glm::vec2(point.x, point.y);
+            hit.normal = glm::vec2(normal.x, normal.y);
+            hit.fraction = fraction;
+
+            if (m_count < m_capacity) {
+                m_hits[m_count++] = hit;
+
+                // keep looking at the whole ray until the buffer fills up
+                if (m_count < m_capacity) {
+                    return 1.f;
                 }
+            } else {
+                // callbacks are only made for hits closer than the farthest one kept
+                m_hits[find_farthest()] = hit;
             }
 
-            // managed scripts
-            std::string event_name = "OnCollision(Entity)";
-            if (entity_a.has_all<script_component>()) {
-                m_scene->verify_script(entity_a);
-
-                auto& sc = entity_a.get_component<script_component>();
-                if (sc._class != nullptr && sc.enabled) {
-                    void* OnCollision = script_engine::get_method(sc._class, event_name);
+            // clip the ray so that only closer hits are reported from now on
+            return m_hits[find_farthest()].fraction;
+        }
 
-                    if (OnCollision != nullptr) {
-                        void* instance = sc.instance->get();
+        size_t get_count() const { return m_count; }
 
-                        void* param = script_helpers::create_entity_object(entity_b);
-                        script_engine::call_method(instance, OnCollision, param);
-                    }
+    private:
+        size_t find_farthest() const {
+            size_t farthest = 0;
+            for (size_t i = 1; i < m_count; i++) {
+                if (m_hits[i].fraction > m_hits[farthest].fraction) {
+                    farthest = i;
                 }
             }
 
-            if (entity_b.has_all<script_component>()) {
-                m_scene->verify_script(entity_b);
+            return farthest;
+        }
 
-                auto& sc = entity_b.get_component<script_component>();
-                if (sc._class != nullptr && sc.enabled) {
-                    void* OnCollision = script_engine::get_method(sc._class, event_name);
+        raycast_hit* m_hits;
+        size_t m_capacity, m_count;
+        uint16_t m_mask;
+    };
 
-                    if (OnCollision != nullptr) {
-                        void* instance = sc.instance->get();
+    class scene_query_callback : public b2QueryCallback {
+    public:
+        scene_query_callback(const b2AABB& aabb, entt::entity* entities, size_t capacity,
+                             uint16_t mask)
+            : m_aabb(aabb) {
+            m_entities = entities;
+            m_capacity = capacity;
+            m_mask = mask;
+            m_count = 0;
+            m_shape = nullptr;
+        }
 
-                        void* param = script_helpers::create_entity_object(entity_a);
-                        script_engine::call_method(instance, OnCollision, param);
-                    }
+        // narrows reported fixtures down to the ones overlapping the given shape
+        void set_shape(const b2Shape* shape, const b2Transform& transform) {
+            m_shape = shape;
+            m_transform = transform;
+        }
+
+        virtual bool ReportFixture(b2Fixture* fixture) override {
+            if ((fixture->GetFilterData().categoryBits & m_mask) == 0) {
+                return true;
+            }
+
+            // the broadphase reports fattened bounds
+            if (!b2TestOverlap(m_aabb, fixture->GetAABB(0))) {
+                return true;
+            }
+
+            if (m_shape != nullptr) {
+                const b2Transform& transform = fixture->GetBody()->GetTransform();
+                if (!b2TestOverlap(m_shape, 0, fixture->GetShape(), 0, m_transform, transform)) {
+                    return true;
                 }
             }
+
+            m_entities[m_count++] = get_fixture_entity(fixture);
+            return m_count < m_capacity;
         }
 
+        size_t get_count() const { return m_count; }
+
     private:
-        scene_contact_listener(scene* _scene) { m_scene = _scene; }
+        b2AABB m_aabb;
+        const b2Shape* m_shape;
+        b2Transform m_transform;
 
-        scene* m_scene;
+        entt::entity* m_entities;
+        size_t m_capacity, m_count;
+        uint16_t m_mask;
     };
 
     static b2BodyType rigid_body_type_to_box2d_body(rigid_body_component::body_type bt) {
@@ -137,6 +230,23 @@ namespace sge {
         return b2_staticBody;
     }
 
+    scene::scene() {
+        // keep the render queue in sync with every sprite that is added or removed
+        m_registry.on_construct<transform_component>()
+            .connect<&scene::on_render_component_changed>(this);
+        m_registry.on_update<transform_component>()
+            .connect<&scene::on_render_component_changed>(this);
+        m_registry.on_destroy<transform_component>()
+            .connect<&scene::on_render_component_changed>(this);
+
+        m_registry.on_construct<sprite_renderer_component>()
+            .connect<&scene::on_render_component_changed>(this);
+        m_registry.on_update<sprite_renderer_component>()
+            .connect<&scene::on_render_component_changed>(this);
+        m_registry.on_destroy<sprite_renderer_component>()
+            .connect<&scene::on_render_component_changed>(this);
+    }
+
     scene::~scene() {
         {
             auto view = m_registry.view<native_script_component>();
@@ -230,8 +340,8 @@ namespace sge {
             remove_script(e);
         }
 
+        m_managed_entities.erase(e);
         m_registry.destroy(e);
-        recalculate_render_order();
     }
 
     void scene::clear() {
@@ -254,9 +364,17 @@ namespace sge {
         }
 
         m_registry.clear();
+        m_managed_entities.clear();
+        m_render_queue.clear();
+        m_render_queue_dirty.clear();
+        m_render_shader_indices.clear();
+        m_render_texture_indices.clear();
+
         for (std::string& name : m_collision_category_names) {
             name.clear();
         }
+
+        m_simulation_settings = simulation_settings();
     }
 
     void scene::set_script(entity e, void* _class) {
@@ -285,12 +403,58 @@ namespace sge {
     }
 
     void scene::update_physics_data(entity e) {
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) == m_physics_data->bodies.end()) {
-                m_physics_data->bodies.insert(
-                    std::make_pair((entt::entity)e, entity_physics_data()));
+        if (m_physics_data != nullptr) {
+            m_physics_data->dirty.push_back(e);
+        }
+    }
+
+    void scene::on_physics_component_changed(entt::registry& registry, entt::entity id) {
+        m_physics_data->dirty.push_back(id);
+    }
+
+    void scene::on_physics_handle_destroyed(entt::registry& registry, entt::entity id) {
+        b2Body* body = registry.get<physics_handle>(id).body;
+        if (body != nullptr) {
+            m_physics_data->destroyed_bodies.push_back(body);
+        }
+    }
+
+    void scene::sync_physics_bodies() {
+        auto& dirty = m_physics_data->dirty;
+        if (!dirty.empty()) {
+            std::sort(dirty.begin(), dirty.end());
+            dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+            // handles of destroyed entities have already been removed
+            for (entt::entity id : dirty) {
+                if (m_registry.valid(id)) {
+                    sync_physics_body(entity(id, this));
+                }
             }
-            auto& data = m_physics_data->bodies[e];
+
+            dirty.clear();
+        }
+
+        for (b2Body* body : m_physics_data->destroyed_bodies) {
+            m_physics_data->world->DestroyBody(body);
+        }
+
+        m_physics_data->destroyed_bodies.clear();
+    }
+
+    b2Body* scene::get_physics_body(entity e) {
+        auto handle = m_registry.try_get<physics_handle>(e);
+        if (handle == nullptr || handle->body == nullptr) {
+            sync_physics_body(e);
+            handle = m_registry.try_get<physics_handle>(e);
+        }
+
+        return handle->body;
+    }
+
+    void scene::sync_physics_body(entity e) {
+        if (e.has_all<rigid_body_component>()) {
+            auto& data = m_registry.get_or_emplace<physics_handle>(e);
 
             auto& rb = e.get_component<rigid_body_component>();
             auto& transform = e.get_component<transform_component>();
@@ -303,12 +467,28 @@ namespace sge {
                 body_def.fixedRotation = rb.fixed_rotation;
 
                 data.body = m_physics_data->world->CreateBody(&body_def);
+                data.previous_translation = transform.translation;
+                data.previous_rotation = transform.rotation;
             } else {
-                b2Vec2 position;
-                position.x = transform.translation.x;
-                position.y = transform.translation.y;
+                // the transform is written back from the body exactly like this after each step,
+                // so anything that differs was moved by something other than the simulation
+                const b2Vec2& body_position = data.body->GetPosition();
+                bool moved = body_position.x != transform.translation.x ||
+                             body_position.y != transform.translation.y ||
+                             glm::degrees(data.body->GetAngle()) != transform.rotation;
+
+                if (moved) {
+                    b2Vec2 position;
+                    position.x = transform.translation.x;
+                    position.y = transform.translation.y;
+
+                    data.body->SetTransform(position, glm::radians(transform.rotation));
+
+                    // a teleport; don't blend from where the body was
+                    data.previous_translation = transform.translation;
+                    data.previous_rotation = transform.rotation;
+                }
 
-                data.body->SetTransform(position, glm::radians(transform.rotation));
                 data.body->SetFixedRotation(rb.fixed_rotation);
                 data.body->SetType(rigid_body_type_to_box2d_body(rb.type));
             }
@@ -375,13 +555,8 @@ namespace sge {
                 data.body->DestroyFixture(data.fixture);
                 data.fixture = nullptr;
             }
-        } else if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-            b2Body* body = m_physics_data->bodies[e].body;
-            if (body != nullptr) {
-                m_physics_data->world->DestroyBody(body);
-            }
-
-            m_physics_data->bodies.erase(e);
+        } else {
+            m_registry.remove<physics_handle>(e);
         }
     }
 
@@ -393,61 +568,165 @@ namespace sge {
         return _shader->id;
     }
 
-    void scene::recalculate_render_order() {
-        m_render_order.clear();
+    // stable lsd radix sort on 8-bit digits; digits that are equal across every key are skipped
+    template <typename T>
+    static void radix_sort(std::vector<T>& entries, std::vector<T>& scratch) {
+        static constexpr size_t digit_count = sizeof(uint64_t);
+        static constexpr size_t bucket_count = 256;
 
-        auto group = m_registry.group<transform_component>(entt::get<sprite_renderer_component>);
-        if (group.empty()) {
-            return;
+        std::array<std::array<size_t, bucket_count>, digit_count> histograms;
+        for (auto& histogram : histograms) {
+            histogram.fill(0);
         }
 
-        std::map<int32_t, std::unordered_map<guid, size_t>> z_layers;
-        std::optional<int32_t> upper_z_bound;
+        for (const auto& entry : entries) {
+            for (size_t digit = 0; digit < digit_count; digit++) {
+                histograms[digit][(entry.key >> (digit * 8)) & 0xFF]++;
+            }
+        }
 
-        std::vector<entity> entities;
-        for (auto _entity : group) {
-            const auto& [transform, sprite] =
-                group.get<transform_component, sprite_renderer_component>(_entity);
+        scratch.resize(entries.size());
+        for (size_t digit = 0; digit < digit_count; digit++) {
+            auto& histogram = histograms[digit];
 
-            if (!upper_z_bound.has_value() || transform.z_layer > upper_z_bound.value()) {
-                upper_z_bound = transform.z_layer;
+            size_t first_key = (entries[0].key >> (digit * 8)) & 0xFF;
+            if (histogram[first_key] == entries.size()) {
+                continue;
             }
 
-            auto& shader_indices = z_layers[transform.z_layer];
-            guid id = get_shader_guid(sprite._shader);
+            size_t offset = 0;
+            for (size_t& count : histogram) {
+                size_t bucket_size = count;
+                count = offset;
+                offset += bucket_size;
+            }
 
-            if (shader_indices.find(id) == shader_indices.end()) {
-                shader_indices.insert(std::make_pair(id, 0));
+            for (const auto& entry : entries) {
+                scratch[histogram[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
             }
 
-            entities.push_back(entity(_entity, this));
+            entries.swap(scratch);
         }
+    }
 
-        for (auto _entity : entities) {
-            const auto& transform = _entity.get_component<transform_component>();
-            const auto& sprite = _entity.get_component<sprite_renderer_component>();
+    void scene::update_render_order(entity e) { m_render_queue_dirty.push_back(e); }
+    void scene::recalculate_render_order() { m_render_queue_invalid = true; }
 
-            guid id = get_shader_guid(sprite._shader);
-            size_t insert_index = z_layers[transform.z_layer][id];
+    void scene::on_render_component_changed(entt::registry& registry, entt::entity id) {
+        m_render_queue_dirty.push_back(id);
+    }
 
-            {
-                auto it = m_render_order.begin();
-                std::advance(it, insert_index);
-                m_render_order.insert(it, _entity);
+    uint64_t scene::get_render_key(const transform_component& transform,
+                                   const sprite_renderer_component& sprite) {
+        // the full 32-bit z layer, then 12 bits of shader index and 20 bits of texture index.
+        // indices are handed out in order of first use, so they only group draws - if they
+        // overflow, draws batch worse but are still ordered by layer
+        static constexpr uint64_t shader_index_mask = (1 << 12) - 1;
+        static constexpr uint64_t texture_index_mask = (1 << 20) - 1;
+
+        // bias so that negative layers sort first
+        static constexpr int64_t min_z_layer = std::numeric_limits<int32_t>::min();
+        uint64_t z_bits = (uint64_t)((int64_t)transform.z_layer - min_z_layer);
+
+        guid shader_id = get_shader_guid(sprite._shader);
+        auto shader_it = m_render_shader_indices.find(shader_id);
+        if (shader_it == m_render_shader_indices.end()) {
+            uint32_t index = (uint32_t)m_render_shader_indices.size();
+            shader_it = m_render_shader_indices.insert(std::make_pair(shader_id, index)).first;
+        }
+
+        // untextured sprites take index 0
+        uint64_t texture_index = 0;
+        if (sprite.texture) {
+            guid texture_id = sprite.texture->id;
+            auto texture_it = m_render_texture_indices.find(texture_id);
+            if (texture_it == m_render_texture_indices.end()) {
+                uint32_t index = (uint32_t)m_render_texture_indices.size() + 1;
+                texture_it =
+                    m_render_texture_indices.insert(std::make_pair(texture_id, index)).first;
             }
 
-            auto main_it = z_layers.find(transform.z_layer);
-            auto sub_map = &main_it->second;
+            texture_index = texture_it->second;
+        }
+
+        return (z_bits << 32) | (((uint64_t)shader_it->second & shader_index_mask) << 20) |
+               (texture_index & texture_index_mask);
+    }
+
+    void scene::update_render_queue() {
+        profiler_scope scope("render_queue_update");
+        auto view = m_registry.view<transform_component, sprite_renderer_component>();
 
-            for (auto sub_it = sub_map->find(id); sub_it != sub_map->end(); sub_it++) {
-                sub_it->second++;
+        if (m_render_queue_invalid) {
+            m_render_queue.clear();
+
+            // every key is recomputed, so indices of assets that are no longer drawn can go
+            m_render_shader_indices.clear();
+            m_render_texture_indices.clear();
+
+            for (entt::entity id : view) {
+                const auto& [transform, sprite] =
+                    view.get<transform_component, sprite_renderer_component>(id);
+
+                m_render_queue.push_back({ get_render_key(transform, sprite), id });
             }
 
-            for (main_it++; main_it != z_layers.end(); main_it++) {
-                for (auto& [shader_id, index] : main_it->second) {
-                    index++;
-                }
+            if (!m_render_queue.empty()) {
+                radix_sort(m_render_queue, m_render_queue_scratch);
+            }
+
+            m_render_queue_dirty.clear();
+            m_render_queue_invalid = false;
+            return;
+        }
+
+        if (m_render_queue_dirty.empty()) {
+            return;
+        }
+
+        // processing dirty entities in id order keeps ties deterministic
+        auto& dirty = m_render_queue_dirty;
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        // drop the old entries of every dirty entity, then re-add the ones that still draw
+        auto is_dirty = [&](const render_queue_entry_t& entry) {
+            return std::binary_search(dirty.begin(), dirty.end(), entry.id);
+        };
+
+        m_render_queue.erase(std::remove_if(m_render_queue.begin(), m_render_queue.end(), is_dirty),
+                             m_render_queue.end());
+
+        size_t sorted_count = m_render_queue.size();
+        for (entt::entity id : dirty) {
+            if (!m_registry.valid(id) || !view.contains(id)) {
+                continue;
             }
+
+            const auto& [transform, sprite] =
+                view.get<transform_component, sprite_renderer_component>(id);
+
+            m_render_queue.push_back({ get_render_key(transform, sprite), id });
+        }
+
+        dirty.clear();
+
+        // merging a few new entries is linear; past that, resorting everything is cheaper
+        size_t added_count = m_render_queue.size() - sorted_count;
+        if (added_count == 0) {
+            return;
+        }
+
+        if (added_count > m_render_queue.size() / 4) {
+            radix_sort(m_render_queue, m_render_queue_scratch);
+        } else {
+            auto compare = [](const render_queue_entry_t& lhs, const render_queue_entry_t& rhs) {
+                return lhs.key < rhs.key;
+            };
+
+            auto middle = m_render_queue.begin() + sorted_count;
+            std::stable_sort(middle, m_render_queue.end(), compare);
+            std::inplace_merge(m_render_queue.begin(), middle, m_render_queue.end(), compare);
         }
     }
 
@@ -456,13 +735,10 @@ namespace sge {
             return false;
         }
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
         // apply the force
         b2Vec2 b2_force(force.x, force.y);
         b2Vec2 b2_point(point.x, point.y);
-        m_physics_data->bodies[e].body->ApplyForce(b2_force, b2_point, wake);
+        get_physics_body(e)->ApplyForce(b2_force, b2_point, wake);
 
         return true;
     }
@@ -472,12 +748,9 @@ namespace sge {
             return false;
         }
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
         // apply the force
         b2Vec2 b2_force(force.x, force.y);
-        m_physics_data->bodies[e].body->ApplyForceToCenter(b2_force, wake);
+        get_physics_body(e)->ApplyForceToCenter(b2_force, wake);
 
         return true;
     }
@@ -487,13 +760,10 @@ namespace sge {
             return false;
         }
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
         // apply the impulse
         b2Vec2 b2_impulse(impulse.x, impulse.y);
         b2Vec2 b2_point(point.x, point.y);
-        m_physics_data->bodies[e].body->ApplyLinearImpulse(b2_impulse, b2_point, wake);
+        get_physics_body(e)->ApplyLinearImpulse(b2_impulse, b2_point, wake);
 
         return true;
     }
@@ -503,12 +773,9 @@ namespace sge {
             return false;
         }
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
         // apply the impulse
         b2Vec2 b2_impulse(impulse.x, impulse.y);
-        m_physics_data->bodies[e].body->ApplyLinearImpulseToCenter(b2_impulse, wake);
+        get_physics_body(e)->ApplyLinearImpulseToCenter(b2_impulse, wake);
 
         return true;
     }
@@ -518,37 +785,28 @@ namespace sge {
             return false;
         }
 
-        // verify that the given entity has a b2Body attached
-        update_physics_data(e);
-
         // apply the torque
-        m_physics_data->bodies[e].body->ApplyTorque(torque, wake);
+        get_physics_body(e)->ApplyTorque(torque, wake);
         return true;
     }
 
     std::optional<glm::vec2> scene::get_velocity(entity e) {
         std::optional<glm::vec2> velocity;
 
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-                b2Body* body = m_physics_data->bodies[e].body;
-
-                const auto& linear_velocity = body->GetLinearVelocity();
-                velocity = glm::vec2(linear_velocity.x, linear_velocity.y);
-            }
+        auto handle = m_registry.try_get<physics_handle>(e);
+        if (handle != nullptr && handle->body != nullptr) {
+            const auto& linear_velocity = handle->body->GetLinearVelocity();
+            velocity = glm::vec2(linear_velocity.x, linear_velocity.y);
         }
 
         return velocity;
     }
 
     bool scene::set_velocity(entity e, glm::vec2 velocity) {
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-                b2Body* body = m_physics_data->bodies[e].body;
-                body->SetLinearVelocity(b2Vec2(velocity.x, velocity.y));
-
-                return true;
-            }
+        auto handle = m_registry.try_get<physics_handle>(e);
+        if (handle != nullptr && handle->body != nullptr) {
+            handle->body->SetLinearVelocity(b2Vec2(velocity.x, velocity.y));
+            return true;
         }
 
         return false;
@@ -557,29 +815,90 @@ namespace sge {
     std::optional<float> scene::get_angular_velocity(entity e) {
         std::optional<float> velocity;
 
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-                b2Body* body = m_physics_data->bodies[e].body;
-                velocity = body->GetAngularVelocity();
-            }
+        auto handle = m_registry.try_get<physics_handle>(e);
+        if (handle != nullptr && handle->body != nullptr) {
+            velocity = handle->body->GetAngularVelocity();
         }
 
         return velocity;
     }
 
     bool scene::set_angular_velocity(entity e, float velocity) {
-        if (e.has_all<rigid_body_component>()) {
-            if (m_physics_data->bodies.find(e) != m_physics_data->bodies.end()) {
-                b2Body* body = m_physics_data->bodies[e].body;
-                body->SetAngularVelocity(velocity);
-
-                return true;
-            }
+        auto handle = m_registry.try_get<physics_handle>(e);
+        if (handle != nullptr && handle->body != nullptr) {
+            handle->body->SetAngularVelocity(velocity);
+            return true;
         }
 
         return false;
     }
 
+    bool scene::prepare_query() {
+        if (m_physics_data == nullptr) {
+            return false;
+        }
+
+        // queries made between steps should see changes that have not been pushed yet
+        if (!m_physics_data->world->IsLocked()) {
+            sync_physics_bodies();
+        }
+
+        return true;
+    }
+
+    size_t scene::raycast(glm::vec2 start, glm::vec2 end, raycast_hit* hits, size_t capacity,
+                          uint16_t mask) {
+        if (capacity == 0 || start == end || !prepare_query()) {
+            return 0;
+        }
+
+        scene_raycast_callback callback(hits, capacity, mask);
+        m_physics_data->world->RayCast(&callback, b2Vec2(start.x, start.y), b2Vec2(end.x, end.y));
+
+        size_t count = callback.get_count();
+        std::sort(hits, hits + count, [](const raycast_hit& lhs, const raycast_hit& rhs) {
+            return lhs.fraction < rhs.fraction;
+        });
+
+        return count;
+    }
+
+    size_t scene::query_aabb(glm::vec2 min, glm::vec2 max, entt::entity* entities,
+                             size_t capacity, uint16_t mask) {
+        if (capacity == 0 || !prepare_query()) {
+            return 0;
+        }
+
+        b2AABB aabb;
+        aabb.lowerBound = b2Vec2(glm::min(min.x, max.x), glm::min(min.y, max.y));
+        aabb.upperBound = b2Vec2(glm::max(min.x, max.x), glm::max(min.y, max.y));
+
+        scene_query_callback callback(aabb, entities, capacity, mask);
+        m_physics_data->world->QueryAABB(&callback, aabb);
+
+        return callback.get_count();
+    }
+
+    size_t scene::overlap_box(glm::vec2 center, glm::vec2 half_extents, float rotation,
+                              entt::entity* entities, size_t capacity, uint16_t mask) {
+        if (capacity == 0 || !prepare_query()) {
+            return 0;
+        }
+
+        b2PolygonShape shape;
+        shape.SetAsBox(glm::abs(half_extents.x), glm::abs(half_extents.y));
+
+        b2Transform transform(b2Vec2(center.x, center.y), b2Rot(glm::radians(rotation)));
+        b2AABB aabb;
+        shape.ComputeAABB(&aabb, transform, 0);
+
+        scene_query_callback callback(aabb, entities, capacity, mask);
+        callback.set_shape(&shape, transform);
+        m_physics_data->world->QueryAABB(&callback, aabb);
+
+        return callback.get_count();
+    }
+
     entity scene::find_guid(guid id) {
         entity found;
 
@@ -597,9 +916,42 @@ namespace sge {
         return found;
     }
 
+    void* scene::get_managed_object() {
+        void* object = m_managed_object ? m_managed_object->get() : nullptr;
+
+        // handles are invalidated when the script domain is unloaded
+        if (object == nullptr) {
+            object = script_helpers::alloc_scene_object(this);
+            m_managed_object = object_ref::from_object(object);
+        }
+
+        return object;
+    }
+
+    void* scene::get_managed_object(entity e) {
+        auto& handle = m_managed_entities[e];
+        void* object = handle ? handle->get() : nullptr;
+
+        if (object == nullptr) {
+            object = script_helpers::alloc_entity_object(e, get_managed_object());
+            handle = object_ref::from_object(object);
+        }
+
+        return object;
+    }
+
+    void scene::release_managed_objects() {
+        m_update_batches.clear();
+        m_fixed_update_batches.clear();
+
+        m_managed_entities.clear();
+        m_managed_object.reset();
+    }
+
     ref<scene> scene::copy() {
         auto new_scene = ref<scene>::create();
         new_scene->m_collision_category_names = m_collision_category_names;
+        new_scene->m_simulation_settings = m_simulation_settings;
 
         // Map from the entt entity id in the old scene to the new scene
         std::unordered_map<entt::entity, entt::entity> entity_map;
@@ -653,6 +1005,27 @@ namespace sge {
             m_physics_data->world = new b2World(b2Vec2(0.f, -9.8f));
             m_physics_data->listener = scene_contact_listener::create(this);
             m_physics_data->world->SetContactListener(m_physics_data->listener.get());
+
+            // from here on, only bodies whose components change are pushed to box2d
+            m_registry.on_update<transform_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_construct<rigid_body_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_update<rigid_body_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_destroy<rigid_body_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_construct<box_collider_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_update<box_collider_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_destroy<box_collider_component>()
+                .connect<&scene::on_physics_component_changed>(this);
+            m_registry.on_destroy<physics_handle>()
+                .connect<&scene::on_physics_handle_destroyed>(this);
+
+            auto view = m_registry.view<rigid_body_component>();
+            m_physics_data->dirty.assign(view.begin(), view.end());
         }
 
         // Call OnStart method, if it exists
@@ -667,7 +1040,7 @@ namespace sge {
                     continue;
                 }
 
-                void* OnStart = script_engine::get_method(sc._class, "OnStart()");
+                void* OnStart = sc.methods->on_start;
                 if (OnStart != nullptr) {
                     void* instance = sc.instance->get();
                     script_engine::call_method(instance, OnStart);
@@ -689,7 +1062,7 @@ namespace sge {
                     continue;
                 }
 
-                void* OnStop = script_engine::get_method(sc._class, "OnStop()");
+                void* OnStop = sc.methods->on_stop;
                 if (OnStop != nullptr) {
                     void* instance = sc.instance->get();
                     script_engine::call_method(instance, OnStop);
@@ -698,14 +1071,44 @@ namespace sge {
         }
 
         // Delete physics data
+        m_registry.on_update<transform_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_construct<rigid_body_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_update<rigid_body_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_destroy<rigid_body_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_construct<box_collider_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_update<box_collider_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_destroy<box_collider_component>()
+            .disconnect<&scene::on_physics_component_changed>(this);
+        m_registry.on_destroy<physics_handle>()
+            .disconnect<&scene::on_physics_handle_destroyed>(this);
+
+        // the world owns every body, so the handles can simply be dropped
+        m_registry.clear<physics_handle>();
+
         delete m_physics_data->world;
         delete m_physics_data;
         m_physics_data = nullptr;
     }
 
+    // script thunks take SGE.Timestep boxed
+    static void* box_timestep(timestep ts) {
+        void* timestep_class = script_helpers::get_core_type("SGE.Timestep", true);
+
+        double value = ts.count();
+        return script_engine::box_object(timestep_class, &value);
+    }
+
     void scene::on_runtime_update(timestep ts) {
         // Native Scripts
         {
+            profiler_scope scope("native_scripts");
+
             auto view = m_registry.view<native_script_component>();
             for (auto id : view) {
                 entity entity(id, this);
@@ -723,54 +1126,62 @@ namespace sge {
 
         // Managed Scripts
         {
-            auto view = m_registry.view<script_component>();
-            for (auto id : view) {
-                entity e(id, this);
-                if (!e) {
-                    continue;
-                }
+            profiler_scope scope("managed_scripts");
 
-                verify_script(e);
-                auto& sc = e.get_component<script_component>();
-                if (sc._class == nullptr || !sc.enabled) {
-                    continue;
-                }
+            if (m_simulation_settings.batch_script_updates) {
+                dispatch_script_batches(false, ts);
+            } else {
+                void* boxed_timestep = box_timestep(ts);
 
-                void* OnUpdate = script_engine::get_method(sc._class, "OnUpdate(Timestep)");
-                if (OnUpdate != nullptr) {
-                    void* instance = sc.instance->get();
+                auto view = m_registry.view<script_component>();
+                for (auto id : view) {
+                    entity e(id, this);
+                    if (!e) {
+                        continue;
+                    }
+
+                    verify_script(e);
+                    auto& sc = e.get_component<script_component>();
+                    if (sc._class == nullptr || !sc.enabled) {
+                        continue;
+                    }
 
-                    double timestep_data = ts.count();
-                    script_engine::call_method(instance, OnUpdate, &timestep_data);
+                    void* OnUpdate = sc.methods->on_update_thunk;
+                    if (OnUpdate != nullptr) {
+                        void* instance = sc.instance->get();
+                        script_engine::call_thunk(OnUpdate, instance, boxed_timestep);
+                    }
                 }
             }
         }
 
         // Physics
         {
-            // update physics data for every entity in the scene
-            for_each([this](entity e) { update_physics_data(e); });
-
-            // update physics world
-            static constexpr int32_t velocity_iterations = 6;
-            static constexpr int32_t position_iterations = 2;
-            m_physics_data->world->Step(ts.count(), velocity_iterations, position_iterations);
+            const auto& settings = m_simulation_settings;
+            if (settings.fixed_timestep && settings.tick_rate > 0.0) {
+                timestep step(1.0 / settings.tick_rate);
+                m_physics_data->accumulator += ts.count();
+
+                uint32_t substeps = 0;
+                while (m_physics_data->accumulator >= step.count()) {
+                    if (substeps == settings.max_substeps) {
+                        // drop the backlog; the game slows down instead of spiraling
+                        m_physics_data->accumulator =
+                            std::fmod(m_physics_data->accumulator, step.count());
 
-            // sync position data
-            auto view = m_registry.view<transform_component, rigid_body_component>();
-            for (entt::entity id : view) {
-                entity e(id, this);
-                auto& transform = e.get_component<transform_component>();
+                        break;
+                    }
 
-                if (m_physics_data->bodies.find(e) == m_physics_data->bodies.end()) {
-                    continue;
+                    fixed_update(step);
+                    m_physics_data->accumulator -= step.count();
+                    substeps++;
                 }
 
-                b2Body* body = m_physics_data->bodies[e].body;
-                const auto& position = body->GetPosition();
-                transform.translation.x = position.x;
-                transform.translation.y = position.y;
-                transform.rotation = glm::degrees(body->GetAngle());
+                m_physics_data->interpolation_alpha =
+                    (float)(m_physics_data->accumulator / step.count());
+            } else {
+                fixed_update(ts);
+                m_physics_data->interpolation_alpha = 1.f;
             }
         }
 
@@ -809,11 +1220,284 @@ namespace sge {
             }
 
             renderer::begin_scene(view_projection);
-            render();
+            {
+                profiler_scope scope("render_order");
+                render();
+            }
             renderer::end_scene();
         }
     }
 
+    void scene::fixed_update(timestep ts) {
+        // Native Scripts
+        {
+            profiler_scope scope("native_scripts");
+
+            auto view = m_registry.view<native_script_component>();
+            for (auto id : view) {
+                auto& nsc = view.get<native_script_component>(id);
+                if (nsc.script != nullptr) {
+                    nsc.script->on_fixed_update(ts);
+                }
+            }
+        }
+
+        // Managed Scripts
+        {
+            profiler_scope scope("managed_scripts");
+
+            if (m_simulation_settings.batch_script_updates) {
+                dispatch_script_batches(true, ts);
+            } else {
+                void* boxed_timestep = box_timestep(ts);
+
+                auto view = m_registry.view<script_component>();
+                for (auto id : view) {
+                    auto& sc = view.get<script_component>(id);
+                    if (sc._class == nullptr || !sc.enabled) {
+                        continue;
+                    }
+
+                    sc.verify_script(entity(id, this));
+                    void* OnFixedUpdate = sc.methods->on_fixed_update_thunk;
+                    if (OnFixedUpdate != nullptr) {
+                        void* instance = sc.instance->get();
+                        script_engine::call_thunk(OnFixedUpdate, instance, boxed_timestep);
+                    }
+                }
+            }
+        }
+
+        // push changed bodies to box2d
+        {
+            profiler_scope scope("physics_sync");
+            sync_physics_bodies();
+        }
+
+        // update physics world
+        {
+            profiler_scope scope("physics_step");
+
+            const auto& settings = m_simulation_settings;
+            m_physics_data->world->Step(ts.count(), settings.velocity_iterations,
+                                        settings.position_iterations);
+        }
+
+        // sync position data. bodies that did not move during the step are skipped
+        {
+            profiler_scope scope("physics_sync");
+            auto view = m_registry.view<physics_handle, transform_component>();
+            for (entt::entity id : view) {
+                auto& [handle, transform] = view.get<physics_handle, transform_component>(id);
+
+                b2Body* body = handle.body;
+                if (body->GetType() == b2_staticBody || !body->IsAwake()) {
+                    continue;
+                }
+
+                handle.previous_translation = transform.translation;
+                handle.previous_rotation = transform.rotation;
+
+                const auto& position = body->GetPosition();
+                transform.translation.x = position.x;
+                transform.translation.y = position.y;
+                transform.rotation = glm::degrees(body->GetAngle());
+            }
+        }
+
+        // run collision callbacks now that the world is unlocked
+        {
+            profiler_scope scope("contact_dispatch");
+            dispatch_contacts();
+        }
+    }
+
+    void scene::dispatch_script_batches(bool fixed, timestep ts) {
+        auto& batches = fixed ? m_fixed_update_batches : m_update_batches;
+        for (auto& [_class, batch] : batches) {
+            batch.entities.clear();
+        }
+
+        // group scripts by class
+        {
+            auto view = m_registry.view<script_component>();
+            for (entt::entity id : view) {
+                auto& sc = view.get<script_component>(id);
+                if (sc._class == nullptr || !sc.enabled) {
+                    continue;
+                }
+
+                sc.verify_script(entity(id, this));
+                const auto& methods = *sc.methods;
+
+                void* thunk = fixed ? methods.on_fixed_update_thunk : methods.on_update_thunk;
+                if (thunk != nullptr) {
+                    batches[sc._class].entities.push_back(id);
+                }
+            }
+        }
+
+        // scripts run between batches, so every entity is checked again before it is dispatched
+        auto get_script = [this](entt::entity id, void* _class) -> script_component* {
+            if (!m_registry.valid(id)) {
+                return nullptr;
+            }
+
+            auto sc = m_registry.try_get<script_component>(id);
+            if (sc == nullptr || sc->_class != _class || !sc->enabled || !sc->instance) {
+                return nullptr;
+            }
+
+            return sc;
+        };
+
+        const char* method_name = fixed ? "OnFixedUpdate" : "OnUpdate";
+        void* boxed_timestep = nullptr;
+
+        for (auto& [_class, batch] : batches) {
+            if (batch.entities.empty() && batch.previous_count == 0) {
+                continue;
+            }
+
+            void* dispatcher = batch.dispatcher ? batch.dispatcher->get() : nullptr;
+            if (dispatcher == nullptr && batch.supported) {
+                dispatcher = script_helpers::create_script_dispatcher(_class, method_name);
+
+                if (dispatcher != nullptr) {
+                    void* dispatcher_class = script_engine::get_class_from_object(dispatcher);
+                    batch.dispatch_method = script_engine::get_method(dispatcher_class, "Dispatch");
+                    batch.dispatcher = object_ref::from_object(dispatcher);
+                } else {
+                    batch.supported = false;
+                }
+            }
+
+            if (!batch.supported) {
+                if (boxed_timestep == nullptr) {
+                    boxed_timestep = box_timestep(ts);
+                }
+
+                for (entt::entity id : batch.entities) {
+                    auto sc = get_script(id, _class);
+                    if (sc != nullptr) {
+                        void* thunk = fixed ? sc->methods->on_fixed_update_thunk
+                                            : sc->methods->on_update_thunk;
+
+                        script_engine::call_thunk(thunk, sc->instance->get(), boxed_timestep);
+                    }
+                }
+
+                continue;
+            }
+
+            void* instances = batch.instances ? batch.instances->get() : nullptr;
+            if (instances == nullptr || batch.capacity < batch.entities.size()) {
+                batch.capacity = std::max(batch.entities.size(), batch.capacity * 2);
+
+                void* script_class = script_helpers::get_core_type("SGE.Script", true);
+                instances = script_engine::create_array(script_class, batch.capacity);
+
+                batch.instances = object_ref::from_object(instances);
+                batch.previous_count = 0;
+            }
+
+            // nothing is allocated from here on, so object addresses stay put until the call
+            int32_t count = 0;
+            for (entt::entity id : batch.entities) {
+                auto sc = get_script(id, _class);
+                if (sc != nullptr) {
+                    script_engine::set_array_element(instances, count++, sc->instance->get());
+                }
+            }
+
+            // don't keep scripts from previous frames alive
+            for (size_t i = count; i < batch.previous_count; i++) {
+                script_engine::set_array_element(instances, i, nullptr);
+            }
+
+            batch.previous_count = count;
+            if (count > 0) {
+                dispatcher = batch.dispatcher->get();
+
+                double timestep_data = ts.count();
+                script_engine::call_method(dispatcher, batch.dispatch_method, instances, &count,
+                                           &timestep_data);
+            }
+        }
+    }
+
+    void scene::dispatch_contacts() {
+        auto& events = m_physics_data->dispatched_contacts;
+        events.swap(m_physics_data->contacts);
+
+        if (events.empty()) {
+            return;
+        }
+
+        // group by receiver so that each script is resolved once
+        std::stable_sort(events.begin(), events.end(),
+                         [](const contact_event_t& lhs, const contact_event_t& rhs) {
+                             return lhs.receiver < rhs.receiver;
+                         });
+
+        size_t group_start = 0;
+        while (group_start < events.size()) {
+            entt::entity receiver = events[group_start].receiver;
+
+            size_t group_end = group_start + 1;
+            while (group_end < events.size() && events[group_end].receiver == receiver) {
+                group_end++;
+            }
+
+            void* instance = nullptr;
+            const script_methods_t* methods = nullptr;
+
+            if (m_registry.valid(receiver) && m_registry.all_of<script_component>(receiver)) {
+                entity e(receiver, this);
+                verify_script(e);
+
+                auto& sc = e.get_component<script_component>();
+                if (sc._class != nullptr && sc.enabled) {
+                    instance = sc.instance->get();
+                    methods = sc.methods;
+                }
+            }
+
+            for (size_t i = group_start; i < group_end; i++) {
+                const auto& event = events[i];
+
+                // earlier callbacks may have destroyed either entity
+                if (!m_registry.valid(receiver) || !m_registry.valid(event.other)) {
+                    continue;
+                }
+
+                entity other(event.other, this);
+                auto nsc = m_registry.try_get<native_script_component>(receiver);
+                if (nsc != nullptr && nsc->script != nullptr) {
+                    if (event.begin) {
+                        nsc->script->on_collision(other);
+                    } else {
+                        nsc->script->on_collision_end(other);
+                    }
+                }
+
+                if (methods != nullptr) {
+                    void* thunk = event.begin ? methods->on_collision_thunk
+                                              : methods->on_collision_end_thunk;
+
+                    if (thunk != nullptr) {
+                        void* other_object = script_helpers::create_entity_object(other);
+                        script_engine::call_thunk(thunk, instance, other_object);
+                    }
+                }
+            }
+
+            group_start = group_end;
+        }
+
+        events.clear();
+    }
+
     void scene::on_editor_update(timestep ts, const editor_camera& camera) {
         glm::mat4 view_projection = camera.get_view_projection_matrix();
         renderer::begin_scene(view_projection);
@@ -888,8 +1572,8 @@ namespace sge {
                     continue;
                 }
 
-                static const std::string event_name = "OnEvent(Event)";
-                void* OnEvent = script_engine::get_method(sc._class, event_name);
+                verify_script(current);
+                void* OnEvent = sc.methods->on_event_thunk;
                 if (OnEvent == nullptr) {
                     continue;
                 }
@@ -903,11 +1587,10 @@ namespace sge {
                     event_handle = object_ref::from_object(event_instance);
                 }
 
-                verify_script(current);
                 void* script_instance = sc.instance->get();
 
                 void* event_instance = event_handle->get();
-                script_engine::call_method(script_instance, OnEvent, event_instance);
+                script_engine::call_thunk(OnEvent, script_instance, event_instance);
             }
         }
     }
@@ -934,9 +1617,29 @@ namespace sge {
     }
 
     void scene::render() {
-        for (auto _entity : m_render_order) {
-            const auto& transform = _entity.get_component<transform_component>();
-            const auto& sprite = _entity.get_component<sprite_renderer_component>();
+        update_render_queue();
+
+        // between fixed steps, moving bodies are drawn between their last two simulated states
+        float alpha = 1.f;
+        if (m_physics_data != nullptr) {
+            alpha = m_physics_data->interpolation_alpha;
+        }
+
+        for (const auto& entry : m_render_queue) {
+            const auto& [transform, sprite] =
+                m_registry.get<transform_component, sprite_renderer_component>(entry.id);
+
+            glm::vec2 translation = transform.translation;
+            float rotation = transform.rotation;
+
+            if (alpha < 1.f) {
+                auto handle = m_registry.try_get<physics_handle>(entry.id);
+                if (handle != nullptr && handle->body->GetType() != b2_staticBody &&
+                    handle->body->IsAwake()) {
+                    translation = glm::mix(handle->previous_translation, translation, alpha);
+                    rotation = glm::mix(handle->previous_rotation, rotation, alpha);
+                }
+            }
 
             auto _shader = sprite._shader;
             if (!_shader) {
@@ -946,11 +1649,10 @@ namespace sge {
 
             renderer::set_shader(_shader);
             if (sprite.texture) {
-                renderer::draw_rotated_quad(transform.translation, transform.rotation,
-                                            transform.scale, sprite.color, sprite.texture);
+                renderer::draw_rotated_quad(translation, rotation, transform.scale, sprite.color,
+                                            sprite.texture);
             } else {
-                renderer::draw_rotated_quad(transform.translation, transform.rotation,
-                                            transform.scale, sprite.color);
+                renderer::draw_rotated_quad(translation, rotation, transform.scale, sprite.color);
             }
         }
     }
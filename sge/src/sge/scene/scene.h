@@ -22,6 +22,7 @@
 #include "sge/core/guid.h"
 #include <entt/entt.hpp>
 
+class b2Body;
 namespace sge {
 
     class entity;
@@ -29,13 +30,41 @@ namespace sge {
     struct script_deserializer;
     class scene_contact_listener;
     struct scene_physics_data;
+    struct transform_component;
+    struct sprite_renderer_component;
+    class texture_2d;
+    class object_ref;
+
+    struct simulation_settings {
+        // when disabled, physics steps once per frame with the frame's timestep
+        bool fixed_timestep = true;
+        double tick_rate = 60.0;
+
+        // upper bound on steps per frame; time past it is dropped instead of accumulated
+        uint32_t max_substeps = 5;
+
+        int32_t velocity_iterations = 6;
+        int32_t position_iterations = 2;
+
+        // scripts of the same class are updated through one managed call per class, instead of
+        // one per script. scripts are then updated grouped by class
+        bool batch_script_updates = false;
+    };
+
+    struct raycast_hit {
+        entt::entity id;
+        glm::vec2 point, normal;
+
+        // distance along the ray, from 0 at the start to 1 at the end
+        float fraction;
+    };
 
     // A Scene is a set of entities and components.
     class scene : public ref_counted {
     public:
         static constexpr size_t collision_category_count = sizeof(uint16_t) * 8;
 
-        scene() = default;
+        scene();
         ~scene();
         scene(const scene&) = delete;
         scene& operator=(const scene&) = delete;
@@ -51,7 +80,13 @@ namespace sge {
         void reset_script(entity e);
         void verify_script(entity e);
 
+        // Transform, rigid body and collider changes made in place must be reported here; they
+        // are pushed to box2d before the next step. Added and removed components are tracked.
         void update_physics_data(entity e);
+
+        // Sprites are drawn in order of z layer, shader and texture. Changes to any of these on an
+        // existing component must be reported; the queue is re-sorted on the next render.
+        void update_render_order(entity e);
         void recalculate_render_order();
 
         bool apply_force(entity e, glm::vec2 force, glm::vec2 point, bool wake = true);
@@ -66,13 +101,31 @@ namespace sge {
         std::optional<float> get_angular_velocity(entity e);
         bool set_angular_velocity(entity e, float velocity);
 
+        // Spatial queries against the colliders of a running scene. Results are written to the
+        // caller's buffer and the number written is returned. Colliders whose category is not in
+        // the mask are skipped. Raycast hits are the closest ones found, sorted by distance.
+        size_t raycast(glm::vec2 start, glm::vec2 end, raycast_hit* hits, size_t capacity,
+                       uint16_t mask = 0xffff);
+        size_t query_aabb(glm::vec2 min, glm::vec2 max, entt::entity* entities, size_t capacity,
+                          uint16_t mask = 0xffff);
+        size_t overlap_box(glm::vec2 center, glm::vec2 half_extents, float rotation,
+                           entt::entity* entities, size_t capacity, uint16_t mask = 0xffff);
+
         entity find_guid(guid id);
         ref<scene> copy();
 
+        // Managed SGE.Scene and SGE.Entity wrappers are created on first use and reused until the
+        // entity is destroyed or the scene's managed objects are released.
+        void* get_managed_object();
+        void* get_managed_object(entity e);
+        void release_managed_objects();
+
         std::string& collision_category_name(size_t index) {
             return m_collision_category_names[index];
         }
 
+        simulation_settings& get_simulation_settings() { return m_simulation_settings; }
+
         void on_start();
         void on_stop();
         void on_runtime_update(timestep ts);
@@ -91,6 +144,35 @@ namespace sge {
             }
         }
 
+        // Writes the ids and addresses of every component of a type, for bulk access. Addresses
+        // stay valid until a component of the type is added or removed. Returns the total count,
+        // which may exceed the capacity.
+        template <typename T>
+        size_t get_components(entt::entity* ids, T** components, size_t capacity) {
+            auto view = m_registry.view<T>();
+
+            size_t index = 0;
+            for (auto [id, component] : view.each()) {
+                if (index >= capacity) {
+                    break;
+                }
+
+                ids[index] = id;
+                components[index] = &component;
+                index++;
+            }
+
+            return view.size();
+        }
+
+        // Reports changes made in place to a component, as if it had been replaced.
+        template <typename T>
+        void patch_component(entt::entity id) {
+            if (m_registry.valid(id) && m_registry.all_of<T>(id)) {
+                m_registry.patch<T>(id);
+            }
+        }
+
     private:
         template <typename T>
         void on_component_added(const entity& e, T& component) {
@@ -102,18 +184,63 @@ namespace sge {
             // no behavior
         }
 
+        struct render_queue_entry_t {
+            uint64_t key;
+            entt::entity id;
+        };
+
+        struct script_batch_t {
+            std::vector<entt::entity> entities;
+
+            // the managed dispatcher and the array of instances passed to it
+            ref<object_ref> dispatcher, instances;
+            void* dispatch_method = nullptr;
+            size_t capacity = 0, previous_count = 0;
+
+            // classes without a dispatcher are updated one script at a time
+            bool supported = true;
+        };
+
         void view_iteration(entt::entity id, const std::function<void(entity)>& callback);
+        void fixed_update(timestep ts);
+        void dispatch_script_batches(bool fixed, timestep ts);
+        void dispatch_contacts();
         void render();
 
+        void on_physics_component_changed(entt::registry& registry, entt::entity id);
+        void on_physics_handle_destroyed(entt::registry& registry, entt::entity id);
+        void sync_physics_bodies();
+        void sync_physics_body(entity e);
+        b2Body* get_physics_body(entity e);
+        bool prepare_query();
+
+        void on_render_component_changed(entt::registry& registry, entt::entity id);
+        uint64_t get_render_key(const transform_component& transform,
+                                const sprite_renderer_component& sprite);
+        void update_render_queue();
+
         void remove_script(entity e, void* component = nullptr);
         guid get_guid(entity e);
 
         entt::registry m_registry;
-        std::vector<entity> m_render_order;
+
+        // kept sorted by key; dirty entities are re-keyed and merged in once per frame
+        std::vector<render_queue_entry_t> m_render_queue, m_render_queue_scratch;
+        std::vector<entt::entity> m_render_queue_dirty;
+        bool m_render_queue_invalid = false;
+
+        std::unordered_map<guid, uint32_t> m_render_shader_indices;
+        std::unordered_map<guid, uint32_t> m_render_texture_indices;
+
         uint32_t m_viewport_width, m_viewport_height;
 
+        ref<object_ref> m_managed_object;
+        std::unordered_map<entt::entity, ref<object_ref>> m_managed_entities;
+        std::unordered_map<void*, script_batch_t> m_update_batches, m_fixed_update_batches;
+
         scene_physics_data* m_physics_data = nullptr;
         std::array<std::string, collision_category_count> m_collision_category_names;
+        simulation_settings m_simulation_settings;
 
         friend class entity;
         friend class scene_contact_listener;
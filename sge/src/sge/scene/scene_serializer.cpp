@@ -220,22 +220,10 @@ namespace sge {
         if (component.instance && component.instance->get() != nullptr) {
             void* instance = component.instance->get();
 
-            std::vector<void*> properties;
-            script_engine::iterate_properties(component._class, properties);
-
-            if (!properties.empty()) {
-                json property_data;
-                for (void* property : properties) {
-                    if (!script_helpers::is_property_serializable(property)) {
-                        continue;
-                    }
-
-                    std::string property_name = script_engine::get_property_name(property);
-                    json& result = property_data[property_name];
-
-                    script_helpers::serialize_property(instance, property, result);
-                }
+            json property_data;
+            script_helpers::serialize_properties(instance, component._class, property_data);
 
+            if (!property_data.is_null()) {
                 data["properties"] = property_data;
             }
         }
@@ -247,23 +235,7 @@ namespace sge {
 
             component.verify_script(current_entity);
             void* instance = component.instance->get();
-
-            std::vector<void*> properties;
-            script_engine::iterate_properties(component._class, properties);
-
-            for (void* property : properties) {
-                if (!script_helpers::is_property_serializable(property)) {
-                    continue;
-                }
-
-                std::string property_name = script_engine::get_property_name(property);
-                if (property_data.find(property_name) == property_data.end()) {
-                    continue;
-                }
-
-                const json& data = property_data[property_name];
-                script_helpers::deserialize_property(instance, property, data);
-            }
+            script_helpers::deserialize_properties(instance, component._class, property_data);
         }
     };
 
@@ -414,8 +386,18 @@ namespace sge {
             category_name_array = nullptr;
         }
 
+        const auto& settings = m_scene->m_simulation_settings;
+        json simulation;
+        simulation["fixed_timestep"] = settings.fixed_timestep;
+        simulation["tick_rate"] = settings.tick_rate;
+        simulation["max_substeps"] = settings.max_substeps;
+        simulation["velocity_iterations"] = settings.velocity_iterations;
+        simulation["position_iterations"] = settings.position_iterations;
+        simulation["batch_script_updates"] = settings.batch_script_updates;
+
         data["entities"] = entities;
         data["collision_categories"] = category_name_array;
+        data["simulation"] = simulation;
         current_serialization.reset();
 
         std::ofstream stream(path);
@@ -453,6 +435,27 @@ namespace sge {
             }
         }
 
+        // scenes saved before simulation settings existed keep the defaults
+        if (data.contains("simulation")) {
+            const auto& simulation = data["simulation"];
+            auto& settings = m_scene->m_simulation_settings;
+
+            settings.fixed_timestep = simulation.value("fixed_timestep", settings.fixed_timestep);
+            settings.tick_rate = simulation.value("tick_rate", settings.tick_rate);
+            settings.max_substeps = simulation.value("max_substeps", settings.max_substeps);
+            if (settings.max_substeps == 0) {
+                spdlog::warn("scene has a max_substeps of 0 - clamping to 1");
+                settings.max_substeps = 1;
+            }
+
+            settings.velocity_iterations =
+                simulation.value("velocity_iterations", settings.velocity_iterations);
+            settings.position_iterations =
+                simulation.value("position_iterations", settings.position_iterations);
+            settings.batch_script_updates =
+                simulation.value("batch_script_updates", settings.batch_script_updates);
+        }
+
         for (const auto& entity_data : data["entities"]) {
             deserialize_entity(entity_data);
         }
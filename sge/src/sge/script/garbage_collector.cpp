@@ -21,9 +21,22 @@
 namespace sge {
     struct gc_data_t {
         std::unordered_set<object_ref*> refs;
+        gc_frame_stats frame_stats;
+
+        // collection counts and pause time of the frame in progress
+        int32_t minor_count, major_count;
+        double pause_time = 0.0;
+
+        size_t used_after_full_collection = 0;
+
+        // the nursery is only worth collecting if something was allocated since this was taken
+        size_t used_after_collection = 0;
     };
 
     static std::unique_ptr<gc_data_t> gc_data;
+
+    // kept across script engine reloads
+    static gc_settings gc_settings_data;
     bool object_ref::get_all(std::vector<ref<object_ref>>& refs) {
         refs.clear();
         if (!gc_data) {
@@ -109,6 +122,9 @@ namespace sge {
         }
 
         gc_data = std::make_unique<gc_data_t>();
+        gc_data->minor_count = mono_gc_collection_count(0);
+        gc_data->major_count = mono_gc_collection_count(mono_gc_max_generation());
+        gc_data->used_after_collection = (size_t)mono_gc_get_used_size();
     }
 
     void garbage_collector::shutdown() {
@@ -129,13 +145,82 @@ namespace sge {
         gc_data.reset();
     }
 
+    // runs a collection and adds its pause to the current frame
+    static void collect_generation(int32_t generation) {
+        using namespace std::chrono;
+        auto start = high_resolution_clock::now();
+
+        mono_gc_collect(generation);
+
+        if (gc_data) {
+            duration<double, std::milli> pause = high_resolution_clock::now() - start;
+            gc_data->pause_time += pause.count();
+            gc_data->used_after_collection = (size_t)mono_gc_get_used_size();
+        }
+    }
+
     void garbage_collector::collect(bool wait) {
-        mono_gc_collect(mono_gc_max_generation());
+        collect_generation(mono_gc_max_generation());
+
+        if (gc_data) {
+            gc_data->used_after_full_collection = (size_t)mono_gc_get_used_size();
+        }
 
         if (wait) {
-            while (mono_gc_pending_finalizers()) {
-                // nothing
+            mono_gc_invoke_finalizers();
+        }
+    }
+
+    void garbage_collector::collect_nursery() { collect_generation(0); }
+
+    void garbage_collector::end_frame(timestep work_time) {
+        if (!gc_data) {
+            return;
+        }
+
+        size_t used = (size_t)mono_gc_get_used_size();
+
+        // the runtime collected on its own during the frame
+        if (mono_gc_collection_count(0) != gc_data->minor_count) {
+            gc_data->used_after_collection = used;
+        }
+
+        const auto& settings = gc_settings_data;
+        if (settings.scheduled) {
+            size_t threshold = (size_t)((double)gc_data->used_after_full_collection *
+                                        settings.heap_growth_threshold);
+
+            if (used >= std::max(threshold, settings.minimum_full_collection_size)) {
+                collect();
+            } else if (work_time.count() < settings.frame_budget &&
+                       used > gc_data->used_after_collection) {
+                collect_nursery();
             }
         }
+
+        int32_t minor_count = mono_gc_collection_count(0);
+        int32_t major_count = mono_gc_collection_count(mono_gc_max_generation());
+
+        auto& stats = gc_data->frame_stats;
+        stats.minor_collections = (uint32_t)(minor_count - gc_data->minor_count);
+        stats.major_collections = (uint32_t)(major_count - gc_data->major_count);
+        stats.pause_time = gc_data->pause_time;
+        stats.heap_size = (size_t)mono_gc_get_heap_size();
+        stats.used_size = (size_t)mono_gc_get_used_size();
+
+        gc_data->minor_count = minor_count;
+        gc_data->major_count = major_count;
+        gc_data->pause_time = 0.0;
+    }
+
+    gc_settings& garbage_collector::get_settings() { return gc_settings_data; }
+
+    const gc_frame_stats& garbage_collector::get_frame_stats() {
+        if (!gc_data) {
+            static const gc_frame_stats empty_stats;
+            return empty_stats;
+        }
+
+        return gc_data->frame_stats;
     }
 } // namespace sge
\ No newline at end of file
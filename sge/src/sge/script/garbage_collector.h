@@ -57,12 +57,47 @@ namespace sge {
         ref<object_ref> m_ref;
     };
 
+    struct gc_settings {
+        // when disabled, collections are left entirely to the runtime
+        bool scheduled = true;
+
+        // the nursery is collected at the end of frames whose cpu work took less than this, if
+        // anything was allocated since the last collection
+        double frame_budget = 1.0 / 60.0;
+
+        // a full collection is made once the used heap has grown by this factor since the last one,
+        // and is at least the minimum size
+        double heap_growth_threshold = 2.0;
+        size_t minimum_full_collection_size = 16 * 1024 * 1024;
+    };
+
+    struct gc_frame_stats {
+        // every collection in the frame, including those triggered by allocations
+        uint32_t minor_collections = 0;
+        uint32_t major_collections = 0;
+
+        // time spent in scheduled collections, in milliseconds
+        double pause_time = 0.0;
+
+        size_t heap_size = 0;
+        size_t used_size = 0;
+    };
+
     class garbage_collector {
     public:
         garbage_collector() = delete;
 
         static void init();
         static void shutdown();
+
+        // with wait set, pending finalizers are run before returning
         static void collect(bool wait = false);
+        static void collect_nursery();
+
+        // called once the frame has been presented. work_time excludes waiting on the swapchain
+        static void end_frame(timestep work_time);
+
+        static gc_settings& get_settings();
+        static const gc_frame_stats& get_frame_stats();
     };
 } // namespace sge
\ No newline at end of file
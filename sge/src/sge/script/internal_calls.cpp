@@ -33,8 +33,25 @@ namespace sge {
         std::function<bool(entity)> has;
     };
 
+    // must match SGE.RaycastHit
+    struct managed_raycast_hit_t {
+        glm::vec2 point, normal;
+        float fraction;
+        scene* _scene;
+        uint32_t entity_id;
+    };
+
+    static_assert(sizeof(entt::entity) == sizeof(uint32_t));
+
+    struct bulk_component_callbacks_t {
+        std::function<size_t(scene*, entt::entity*, void**, size_t)> view;
+        std::function<void(scene*, entt::entity)> patch;
+    };
+
     static struct {
         std::unordered_map<void*, component_callbacks_t> component_callbacks;
+        std::unordered_map<void*, bulk_component_callbacks_t> bulk_component_callbacks;
+        std::vector<raycast_hit> raycast_hits;
     } internal_script_call_data;
 
     template <typename T>
@@ -54,6 +71,29 @@ namespace sge {
         internal_script_call_data.component_callbacks.insert(std::make_pair(_class, callbacks));
     }
 
+    // only for components that are plain data; the managed struct must have the same layout
+    template <typename T>
+    static void register_bulk_component_type(const std::string& managed_name) {
+        class_name_t name;
+        name.namespace_name = "SGE.Components";
+        name.class_name = managed_name;
+
+        void* scriptcore = script_engine::get_assembly(0);
+        void* _class = script_engine::get_class(scriptcore, name);
+
+        bulk_component_callbacks_t callbacks;
+        callbacks.view = [](scene* _scene, entt::entity* ids, void** components, size_t capacity) {
+            return _scene->get_components<T>(ids, (T**)components, capacity);
+        };
+
+        callbacks.patch = [](scene* _scene, entt::entity id) {
+            _scene->patch_component<T>(id);
+        };
+
+        auto& bulk_callbacks = internal_script_call_data.bulk_component_callbacks;
+        bulk_callbacks.insert(std::make_pair(_class, callbacks));
+    }
+
     void script_engine::register_component_types() {
         register_component_type<tag_component>("TagComponent");
         register_component_type<transform_component>("TransformComponent");
@@ -62,6 +102,14 @@ namespace sge {
         register_component_type<rigid_body_component>("RigidBodyComponent");
         register_component_type<box_collider_component>("BoxColliderComponent");
         register_component_type<script_component>("ScriptComponent");
+
+        static_assert(sizeof(transform_component) == 24);
+        static_assert(sizeof(rigid_body_component) == 12);
+        static_assert(sizeof(box_collider_component) == 24);
+
+        register_bulk_component_type<transform_component>("TransformData");
+        register_bulk_component_type<rigid_body_component>("RigidBodyData");
+        register_bulk_component_type<box_collider_component>("BoxColliderData");
     }
 
     static void verify_component_type_validity(void* reflection_type) {
@@ -77,6 +125,22 @@ namespace sge {
         }
     }
 
+    static const bulk_component_callbacks_t& get_bulk_component_callbacks(void* data_type) {
+        void* _class = script_engine::from_reflection_type(data_type);
+
+        auto& callbacks = internal_script_call_data.bulk_component_callbacks;
+        auto it = callbacks.find(_class);
+        if (it == callbacks.end()) {
+            class_name_t name_data;
+            script_engine::get_class_name(_class, name_data);
+
+            throw std::runtime_error("managed type " + script_engine::get_string(name_data) +
+                                     " is not registered as a component data type!");
+        }
+
+        return it->second;
+    }
+
     static const component_callbacks_t& get_component_callbacks(void* component_type) {
         void* _class = script_engine::from_reflection_type(component_type);
         return internal_script_call_data.component_callbacks[_class];
@@ -212,6 +276,91 @@ namespace sge {
             return script_engine::to_managed_string(name);
         }
 
+        static int32_t GetComponentView(void* dataType, scene* _scene, void* entityIDs,
+                                        void* addresses) {
+            const auto& callbacks = get_bulk_component_callbacks(dataType);
+
+            size_t capacity = script_engine::get_array_length(addresses);
+            capacity = std::min(capacity, script_engine::get_array_length(entityIDs));
+
+            entt::entity* ids = nullptr;
+            void** components = nullptr;
+
+            if (capacity > 0) {
+                ids = (entt::entity*)script_engine::get_array_data(entityIDs);
+                components = (void**)script_engine::get_array_data(addresses);
+            }
+
+            return (int32_t)callbacks.view(_scene, ids, components, capacity);
+        }
+
+        static void PatchComponents(void* dataType, scene* _scene, void* entityIDs,
+                                    int32_t count) {
+            const auto& callbacks = get_bulk_component_callbacks(dataType);
+
+            size_t length = std::min(script_engine::get_array_length(entityIDs), (size_t)count);
+            if (count <= 0 || length == 0) {
+                return;
+            }
+
+            auto ids = (const entt::entity*)script_engine::get_array_data(entityIDs);
+            for (size_t i = 0; i < length; i++) {
+                callbacks.patch(_scene, ids[i]);
+            }
+        }
+
+        static int32_t Raycast(scene* _scene, glm::vec2 start, glm::vec2 end, uint16_t mask,
+                               void* hits) {
+            size_t capacity = script_engine::get_array_length(hits);
+            if (capacity == 0) {
+                return 0;
+            }
+
+            auto& native_hits = internal_script_call_data.raycast_hits;
+            native_hits.resize(capacity);
+
+            size_t count = _scene->raycast(start, end, native_hits.data(), capacity, mask);
+            auto managed_hits = (managed_raycast_hit_t*)script_engine::get_array_data(hits);
+
+            for (size_t i = 0; i < count; i++) {
+                const auto& hit = native_hits[i];
+                auto& managed_hit = managed_hits[i];
+
+                managed_hit.point = hit.point;
+                managed_hit.normal = hit.normal;
+                managed_hit.fraction = hit.fraction;
+                managed_hit._scene = _scene;
+                managed_hit.entity_id = (uint32_t)hit.id;
+            }
+
+            return (int32_t)count;
+        }
+
+        static int32_t QueryAABB(scene* _scene, glm::vec2 min, glm::vec2 max, uint16_t mask,
+                                 void* entityIDs, int32_t capacity) {
+            size_t length = std::min(script_engine::get_array_length(entityIDs), (size_t)capacity);
+            if (capacity <= 0 || length == 0) {
+                return 0;
+            }
+
+            // entity ids are written straight into the managed array
+            auto entities = (entt::entity*)script_engine::get_array_data(entityIDs);
+            return (int32_t)_scene->query_aabb(min, max, entities, length, mask);
+        }
+
+        static int32_t OverlapBox(scene* _scene, glm::vec2 center, glm::vec2 halfExtents,
+                                  float rotation, uint16_t mask, void* entityIDs,
+                                  int32_t capacity) {
+            size_t length = std::min(script_engine::get_array_length(entityIDs), (size_t)capacity);
+            if (capacity <= 0 || length == 0) {
+                return 0;
+            }
+
+            auto entities = (entt::entity*)script_engine::get_array_data(entityIDs);
+            return (int32_t)_scene->overlap_box(center, halfExtents, rotation, entities, length,
+                                                mask);
+        }
+
         static void* AddComponent(void* componentType, void* _entity) {
             verify_component_type_validity(componentType);
             entity e = script_helpers::get_entity_from_object(_entity);
@@ -255,22 +404,32 @@ namespace sge {
             *translation = component->translation;
         }
 
-        static void SetTranslation(transform_component* component, glm::vec2 translation) {
+        static void SetTranslation(transform_component* component, void* _entity,
+                                   glm::vec2 translation) {
             component->translation = translation;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->update_physics_data(e);
         }
 
         static float GetRotation(transform_component* component) { return component->rotation; }
 
-        static void SetRotation(transform_component* component, float rotation) {
+        static void SetRotation(transform_component* component, void* _entity, float rotation) {
             component->rotation = rotation;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->update_physics_data(e);
         }
 
         static void GetScale(transform_component* component, glm::vec2* scale) {
             *scale = component->scale;
         }
 
-        static void SetScale(transform_component* component, glm::vec2 scale) {
+        static void SetScale(transform_component* component, void* _entity, glm::vec2 scale) {
             component->scale = scale;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->update_physics_data(e);
         }
 
         static int32_t GetZLayer(transform_component* component) { return component->z_layer; }
@@ -280,7 +439,7 @@ namespace sge {
             component->z_layer = z_layer;
 
             entity _entity = script_helpers::get_entity_from_object(entity_object);
-            _entity.get_scene()->recalculate_render_order();
+            _entity.get_scene()->update_render_order(_entity);
         }
 
         static void GetColor(sprite_renderer_component* component, glm::vec4* color) {
@@ -295,8 +454,12 @@ namespace sge {
             *texture = component->texture.raw();
         }
 
-        static void SetTexture(sprite_renderer_component* component, texture_2d* texture) {
+        static void SetTexture(sprite_renderer_component* component, void* entity_object,
+                               texture_2d* texture) {
             component->texture = texture;
+
+            entity _entity = script_helpers::get_entity_from_object(entity_object);
+            _entity.get_scene()->update_render_order(_entity);
         }
 
         static void GetShader(sprite_renderer_component* component, shader** result) {
@@ -308,7 +471,7 @@ namespace sge {
             component->_shader = _shader;
 
             entity _entity = script_helpers::get_entity_from_object(entity_object);
-            _entity.get_scene()->recalculate_render_order();
+            _entity.get_scene()->update_render_order(_entity);
         }
 
         static bool GetPrimary(camera_component* component) { return component->primary; }
@@ -475,16 +638,23 @@ namespace sge {
             return component->filter_category;
         }
 
-        static void SetFilterCategory(rigid_body_component* component, uint16_t category) {
+        static void SetFilterCategory(rigid_body_component* component, void* _entity,
+                                      uint16_t category) {
             component->filter_category = category;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->update_physics_data(e);
         }
 
         static uint16_t GetFilterMask(rigid_body_component* component) {
             return component->filter_mask;
         }
 
-        static void SetFilterMask(rigid_body_component* component, uint16_t mask) {
+        static void SetFilterMask(rigid_body_component* component, void* _entity, uint16_t mask) {
             component->filter_mask = mask;
+
+            entity e = script_helpers::get_entity_from_object(_entity);
+            e.get_scene()->update_physics_data(e);
         }
 
         static void GetSize(box_collider_component* bc, glm::vec2* size) { *size = bc->size; }
@@ -764,6 +934,11 @@ namespace sge {
             REGISTER_FUNC(DestroyEntity);
             REGISTER_FUNC(FindEntity);
             REGISTER_FUNC(ForEach);
+            REGISTER_FUNC(GetComponentView);
+            REGISTER_FUNC(PatchComponents);
+            REGISTER_FUNC(Raycast);
+            REGISTER_FUNC(QueryAABB);
+            REGISTER_FUNC(OverlapBox);
             REGISTER_FUNC(GetCollisionCategoryName);
 
             // entity
@@ -27,15 +27,28 @@ namespace sge {
     using serialize_callback_t = void (*)(void*, json&);
     using deserialize_callback_t = void (*)(void*, void*, const json&);
 
+    // unboxed variants, for primitive value types
+    using serialize_value_callback_t = void (*)(const void*, json&);
+    using deserialize_value_callback_t = void (*)(const json&, void*);
+
+    // large enough for the value of every handler registered with serialize_value and
+    // deserialize_value, so that they can run on a stack buffer
+    static constexpr size_t max_value_handler_size =
+        std::max({ sizeof(int32_t), sizeof(float), sizeof(bool) });
+
     struct handler_callbacks_t {
         edit_callback_t edit;
         serialize_callback_t serialize;
         deserialize_callback_t deserialize;
+
+        serialize_value_callback_t serialize_value = nullptr;
+        deserialize_value_callback_t deserialize_value = nullptr;
     };
 
     static struct {
         ref<scene> editor_scene;
         std::unordered_map<void*, handler_callbacks_t> callbacks;
+        std::unordered_map<void*, std::vector<serializable_property_t>> serializable_properties;
 
         std::unordered_map<void*, std::vector<std::string>> enum_data;
         std::unordered_map<void*, std::vector<const char*>> enum_dropdown_data;
@@ -186,6 +199,14 @@ namespace sge {
                 data = script_engine::unbox_object<int32_t>(object);
             }
 
+            static void serialize_value(const void* value, json& data) {
+                data = *(const int32_t*)value;
+            }
+
+            static void deserialize_value(const json& data, void* value) {
+                *(int32_t*)value = data.get<int32_t>();
+            }
+
             static void deserialize(void* instance, void* property, const json& data) {
                 int32_t value = data.get<int32_t>();
                 script_engine::set_property_value(instance, property, &value);
@@ -207,6 +228,14 @@ namespace sge {
                 data = script_engine::unbox_object<float>(object);
             }
 
+            static void serialize_value(const void* value, json& data) {
+                data = *(const float*)value;
+            }
+
+            static void deserialize_value(const json& data, void* value) {
+                *(float*)value = data.get<float>();
+            }
+
             static void deserialize(void* instance, void* property, const json& data) {
                 float value = data.get<float>();
                 script_engine::set_property_value(instance, property, &value);
@@ -229,6 +258,14 @@ namespace sge {
                 data = script_engine::unbox_object<bool>(object);
             }
 
+            static void serialize_value(const void* value, json& data) {
+                data = *(const bool*)value;
+            }
+
+            static void deserialize_value(const json& data, void* value) {
+                *(bool*)value = data.get<bool>();
+            }
+
             static void deserialize(void* instance, void* property, const json& data) {
                 bool value = data.get<bool>();
                 script_engine::set_property_value(instance, property, &value);
@@ -429,6 +466,110 @@ namespace sge {
         s_handler_data.callbacks.at(_class).deserialize(instance, property, data);
     }
 
+    const std::vector<serializable_property_t>& script_helpers::get_serializable_properties(
+        void* _class) {
+        auto& cache = s_handler_data.serializable_properties;
+
+        auto it = cache.find(_class);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        std::vector<void*> properties;
+        script_engine::iterate_properties(_class, properties);
+
+        std::vector<serializable_property_t> result;
+        for (void* property : properties) {
+            if (!is_property_serializable(property)) {
+                continue;
+            }
+
+            serializable_property_t data;
+            data.property = property;
+            data.name = script_engine::get_property_name(property);
+
+            data.type = script_engine::get_property_type(property);
+            data.type_name = get_type_name_safe(data.type);
+
+            data.read_only = is_property_read_only(property);
+            data.is_enum = type_is_enum(data.type);
+            data.value_type = script_engine::is_value_type(data.type);
+            data.value_size = data.value_type ? script_engine::get_value_size(data.type) : 0;
+
+            data.backing_field = nullptr;
+            if (data.value_type) {
+                std::string field_name = "<" + data.name + ">k__BackingField";
+                data.backing_field = script_engine::get_field(_class, field_name);
+            }
+
+            result.push_back(data);
+        }
+
+        return cache.insert(std::make_pair(_class, std::move(result))).first->second;
+    }
+
+    void script_helpers::serialize_properties(void* instance, void* _class, json& data) {
+        for (const auto& property : get_serializable_properties(_class)) {
+            json& result = data[property.name];
+            if (property.read_only) {
+                continue;
+            }
+
+            if (property.is_enum) {
+                void* object = script_engine::get_property_value(instance, property.property);
+                handlers::serialize_enum(object, property.type, result);
+                continue;
+            }
+
+            auto it = s_handler_data.callbacks.find(property.type);
+            if (it == s_handler_data.callbacks.end()) {
+                continue;
+            }
+
+            const auto& handler = it->second;
+            if (property.backing_field != nullptr && handler.serialize_value != nullptr &&
+                property.value_size <= max_value_handler_size) {
+                alignas(std::max_align_t) uint8_t value[max_value_handler_size];
+                script_engine::get_field_value(instance, property.backing_field, value);
+
+                handler.serialize_value(value, result);
+            } else {
+                void* object = script_engine::get_property_value(instance, property.property);
+                handler.serialize(object, result);
+            }
+        }
+    }
+
+    void script_helpers::deserialize_properties(void* instance, void* _class, const json& data) {
+        for (const auto& property : get_serializable_properties(_class)) {
+            if (property.read_only || data.find(property.name) == data.end()) {
+                continue;
+            }
+
+            const json& property_data = data[property.name];
+            if (property.is_enum) {
+                handlers::deserialize_enum(instance, property.property, property_data);
+                continue;
+            }
+
+            auto it = s_handler_data.callbacks.find(property.type);
+            if (it == s_handler_data.callbacks.end()) {
+                continue;
+            }
+
+            const auto& handler = it->second;
+            if (property.backing_field != nullptr && handler.deserialize_value != nullptr &&
+                property.value_size <= max_value_handler_size) {
+                alignas(std::max_align_t) uint8_t value[max_value_handler_size];
+                handler.deserialize_value(property_data, value);
+
+                script_engine::set_field_value(instance, property.backing_field, value);
+            } else {
+                handler.deserialize(instance, property.property, property_data);
+            }
+        }
+    }
+
     static void register_property_handler(const std::string& managed,
                                           const handler_callbacks_t& handler) {
         bool is_scriptcore = managed.find("SGE.") != std::string::npos;
@@ -450,14 +591,27 @@ namespace sge {
         register_property_handler(managed, handler);                                               \
     }
 
+#define REGISTER_VALUE_HANDLER(native, managed)                                                    \
+    {                                                                                              \
+        handler_callbacks_t handler;                                                               \
+        handler.edit = HANDLER_FUNC(native, edit);                                                 \
+        handler.serialize = HANDLER_FUNC(native, serialize);                                       \
+        handler.deserialize = HANDLER_FUNC(native, deserialize);                                   \
+        handler.serialize_value = HANDLER_FUNC(native, serialize_value);                           \
+        handler.deserialize_value = HANDLER_FUNC(native, deserialize_value);                       \
+                                                                                                   \
+        register_property_handler(managed, handler);                                               \
+    }
+
     void script_helpers::register_property_handlers() {
         s_handler_data.callbacks.clear();
+        s_handler_data.serializable_properties.clear();
         s_handler_data.enum_data.clear();
         s_handler_data.enum_dropdown_data.clear();
 
-        REGISTER_HANDLER(int, "System.Int32");
-        REGISTER_HANDLER(float, "System.Single");
-        REGISTER_HANDLER(bool, "System.Boolean");
+        REGISTER_VALUE_HANDLER(int, "System.Int32");
+        REGISTER_VALUE_HANDLER(float, "System.Single");
+        REGISTER_VALUE_HANDLER(bool, "System.Boolean");
         REGISTER_HANDLER(string, "System.String");
         REGISTER_HANDLER(entity, "SGE.Entity");
         REGISTER_HANDLER(texture_2d, "SGE.Texture2D");
@@ -465,6 +619,7 @@ namespace sge {
         REGISTER_HANDLER(shader, "SGE.Shader");
     }
 
+#undef REGISTER_VALUE_HANDLER
 #undef REGISTER_HANDLER
 #undef HANDLER_FUNC
 } // namespace sge
\ No newline at end of file
@@ -24,6 +24,14 @@
 #include "sge/scene/components.h"
 #include "sge/core/environment.h"
 #include "sge/core/application.h"
+#include "sge/events/script_events.h"
+#include <atomic>
+
+#ifdef SGE_PLATFORM_WINDOWS
+#define SGE_THUNK_CALL __stdcall
+#else
+#define SGE_THUNK_CALL
+#endif
 
 namespace sge {
     void function_registerer::register_call(const std::string& name, const void* function) {
@@ -34,6 +42,9 @@ namespace sge {
         MonoAssembly* assembly = nullptr;
         MonoImage* image = nullptr;
         fs::path path;
+
+        // of the file that was read, to tell whether it has been rebuilt since
+        fs::file_time_type write_time;
     };
 
     struct script_engine_data_t {
@@ -44,9 +55,16 @@ namespace sge {
 
         bool reload_callbacks_locked = false;
         std::vector<std::optional<std::function<void()>>> reload_callbacks;
+
+        std::thread compile_thread;
+        std::atomic<bool> compiling{ false };
+
+        // cleared whenever the script domain is unloaded
+        std::unordered_map<void*, script_methods_t> script_methods;
     };
 
     static std::unique_ptr<script_engine_data_t> script_engine_data;
+    static bool s_aot_enabled = true;
     static void script_engine_init_internal() {
         char domain_name[16];
         strcpy(domain_name, "SGE-Runtime");
@@ -91,6 +109,45 @@ namespace sge {
         std::unordered_map<std::string, std::string> m_data;
     };
 
+#ifdef SGE_MONO_AOT
+    static bool has_aot_image(const fs::path& assembly) {
+        return fs::exists(assembly.string() + SGE_MONO_AOT_SUFFIX);
+    }
+
+    // full and hybrid aot abort as soon as a method has to be jitted, so they're only used if the
+    // images were built by this runtime's version of mono and exist for every core assembly
+    static bool can_use_aot_images() {
+        char* build_info = mono_get_runtime_build_info();
+        std::string runtime_version = build_info;
+        mono_free(build_info);
+
+        if (runtime_version.find(SGE_MONO_AOT_VERSION) != 0) {
+            spdlog::warn("precompiled images were built by mono {0}, but the runtime is {1} - "
+                         "jitting instead",
+                         SGE_MONO_AOT_VERSION, runtime_version);
+
+            return false;
+        }
+
+        fs::path library_dir = fs::current_path() / "assets" / "mono" / "4.5";
+        std::vector<fs::path> assemblies = {
+            library_dir / "mscorlib.dll", library_dir / "System.dll",
+            library_dir / "System.Core.dll",
+            fs::current_path() / "assets" / "assemblies" / project::get_config() /
+                "SGE.Scriptcore.dll"
+        };
+
+        for (const auto& path : assemblies) {
+            if (!has_aot_image(path)) {
+                spdlog::warn("no precompiled image for {0} - jitting instead", path.string());
+                return false;
+            }
+        }
+
+        return true;
+    }
+#endif
+
     void script_engine::init() {
         if (script_engine_data) {
             throw std::runtime_error("the script engine has already been initialized!");
@@ -125,6 +182,32 @@ namespace sge {
         }
 
         mono_jit_parse_options((int)jit_args.size(), jit_args.data());
+
+#ifdef SGE_MONO_AOT
+        // inherited by the aot compiler when precompiling the app assembly, so that references
+        // resolve to the class libraries the runtime uses
+        std::string library_path = (fs::current_path() / "assets" / "mono" / "4.5").string();
+#ifdef SGE_PLATFORM_WINDOWS
+        _putenv_s("MONO_PATH", library_path.c_str());
+#else
+        setenv("MONO_PATH", library_path.c_str(), 1);
+#endif
+
+        // runtime builds run the precompiled images next to each assembly. the editor keeps
+        // jitting so that scripts can be debugged
+        s_aot_enabled &= !script_engine_data->debug_enabled;
+        s_aot_enabled = s_aot_enabled && can_use_aot_images();
+
+        if (s_aot_enabled) {
+            bool full = std::string(SGE_MONO_AOT) == "FULL";
+            mono_jit_set_aot_mode(full ? MONO_AOT_MODE_FULL : MONO_AOT_MODE_HYBRID);
+        } else {
+            mono_jit_set_aot_mode(MONO_AOT_MODE_NONE);
+        }
+#else
+        s_aot_enabled = false;
+#endif
+
         script_engine_data->root_domain = mono_jit_init("SGE");
 
         if (script_engine_data->debug_enabled) {
@@ -141,6 +224,8 @@ namespace sge {
 
     static void script_engine_shutdown_internal() {
         garbage_collector::shutdown();
+        script_engine_data->script_methods.clear();
+
         mono_domain_set(script_engine_data->root_domain, false);
         mono_domain_unload(script_engine_data->script_domain);
     }
@@ -150,11 +235,25 @@ namespace sge {
             throw std::runtime_error("the script engine is not initialized!");
         }
 
+        if (script_engine_data->compile_thread.joinable()) {
+            script_engine_data->compile_thread.join();
+        }
+
         script_engine_shutdown_internal();
         mono_jit_cleanup(script_engine_data->root_domain);
         script_engine_data.reset();
     }
 
+    void script_engine::set_aot_enabled(bool enabled) {
+        if (script_engine_data) {
+            throw std::runtime_error("the script engine has already been initialized!");
+        }
+
+        s_aot_enabled = enabled;
+    }
+
+    bool script_engine::is_aot_enabled() { return s_aot_enabled; }
+
     void script_engine::register_call_group(
         const std::string& managed_group_id,
         const std::function<void(function_registerer&)>& callback) {
@@ -179,32 +278,232 @@ namespace sge {
         callback(registerer);
     }
 
-    bool script_engine::compile_app_assembly() {
-#ifdef SGE_BUILD_SCRIPTCORE
+    static void hash_string(uint64_t& hash, const std::string& data) {
+        // fnv-1a
+        for (char c : data) {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3;
+        }
+
+        hash ^= 0xff;
+        hash *= 0x100000001b3;
+    }
+
+    struct app_assembly_build_t {
+        fs::path project_path, assembly_path, hash_path, scriptcore_path;
+        std::string config, architecture;
+    };
+
+    enum class app_assembly_build_result { up_to_date, succeeded, failed };
+
+    static bool get_app_assembly_build(app_assembly_build_t& build) {
         auto& _project = project::get();
 
-        fs::path project_path = _project.get_script_project_path();
-        if (!fs::exists(project_path)) {
+        build.project_path = _project.get_script_project_path();
+        if (!fs::exists(build.project_path)) {
             return false;
         }
 
+        build.assembly_path = _project.get_assembly_path();
+        build.hash_path = _project.get_assembly_hash_path();
+        build.scriptcore_path = fs::current_path() / "assets" / "assemblies" /
+                                project::get_config() / "SGE.Scriptcore.dll";
+        build.config = project::get_config();
+        build.architecture = project::get_cpu_architecture();
+
+        return true;
+    }
+
+    static std::string read_file(const fs::path& path) {
+        std::ifstream stream(path, std::ios::binary);
+
+        std::stringstream contents;
+        contents << stream.rdbuf();
+        return contents.str();
+    }
+
+    // the project hash covers the project file and the scriptcore it references; the source hash
+    // covers every C# file in the project directory, outside of bin and obj
+    static void hash_app_assembly_sources(const app_assembly_build_t& build,
+                                          uint64_t& project_hash, uint64_t& source_hash) {
+        project_hash = 0xcbf29ce484222325;
+        hash_string(project_hash, build.config);
+        hash_string(project_hash, build.architecture);
+        hash_string(project_hash, read_file(build.project_path));
+        hash_string(project_hash, read_file(build.scriptcore_path));
+
+        fs::path directory = build.project_path.parent_path();
+        std::vector<fs::path> sources;
+
+        for (auto it = fs::recursive_directory_iterator(directory);
+             it != fs::recursive_directory_iterator(); it++) {
+            const auto& path = it->path();
+            if (it->is_directory()) {
+                auto name = path.filename();
+                if (name == "bin" || name == "obj") {
+                    it.disable_recursion_pending();
+                }
+            } else if (path.extension() == ".cs") {
+                sources.push_back(path);
+            }
+        }
+
+        std::sort(sources.begin(), sources.end());
+
+        source_hash = project_hash;
+        for (const auto& path : sources) {
+            hash_string(source_hash, path.lexically_relative(directory).generic_string());
+            hash_string(source_hash, read_file(path));
+        }
+    }
+
+#ifdef SGE_MONO_AOT
+    // writes a precompiled image next to the assembly for runtime builds to load. a failure only
+    // means that the assembly will be jitted
+    static void aot_compile_app_assembly(const app_assembly_build_t& build) {
+        std::string mode = SGE_MONO_AOT;
+        std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+
+        std::stringstream args;
+        args << "\"" << SGE_MONO_EXE << "\" --aot=" << mode;
+        args << " \"" << build.assembly_path.string() << "\"";
+
+        process_info p_info;
+        p_info.executable = SGE_MONO_EXE;
+        p_info.cmdline = args.str();
+        p_info.workdir = build.assembly_path.parent_path();
+
+        spdlog::info("precompiling ScriptAssembly.dll: {0}", p_info.cmdline);
+        int32_t exit_code = environment::run_command(p_info);
+
+        if (exit_code != 0) {
+            spdlog::warn("failed to precompile ScriptAssembly.dll (exit code {0})", exit_code);
+        }
+    }
+#endif
+
+    // safe to call from any thread
+    static app_assembly_build_result build_app_assembly(const app_assembly_build_t& build) {
+#ifdef SGE_BUILD_SCRIPTCORE
+        uint64_t project_hash, source_hash;
+        hash_app_assembly_sources(build, project_hash, source_hash);
+
+        uint64_t built_project_hash = 0, built_source_hash = 0;
+        if (fs::exists(build.hash_path)) {
+            std::ifstream stream(build.hash_path);
+            stream >> built_project_hash >> built_source_hash;
+        }
+
+        if (built_source_hash == source_hash && fs::exists(build.assembly_path)) {
+            spdlog::info("ScriptAssembly.dll is up to date");
+            return app_assembly_build_result::up_to_date;
+        }
+
         std::stringstream args;
         args << "\"" << SGE_DOTNET_EXE << "\" build --nologo";
-        args << " -c " << project::get_config();
-        args << " -a " << project::get_cpu_architecture();
-        args << " \"" << project_path.string() << "\"";
+        args << " -c " << build.config;
+        args << " -a " << build.architecture;
+
+        // msbuild nodes and the compiler server stay alive between builds
+        args << " -nodeReuse:true -p:UseSharedCompilation=true";
+
+        fs::path assets_path = build.project_path.parent_path() / "obj" / "project.assets.json";
+        if (built_project_hash == project_hash && fs::exists(assets_path)) {
+            args << " --no-restore";
+        }
+
+        args << " \"" << build.project_path.string() << "\"";
 
         process_info p_info;
         p_info.executable = SGE_DOTNET_EXE;
         p_info.cmdline = args.str();
 
         spdlog::info("compiling ScriptAssembly.dll: {0}", p_info.cmdline);
-        environment::run_command(p_info);
+        int32_t exit_code = environment::run_command(p_info);
+
+        if (exit_code != 0) {
+            spdlog::error("failed to compile ScriptAssembly.dll (exit code {0})", exit_code);
+            return app_assembly_build_result::failed;
+        }
+
+#ifdef SGE_MONO_AOT
+        aot_compile_app_assembly(build);
 #endif
 
+        std::ofstream stream(build.hash_path);
+        stream << project_hash << " " << source_hash << std::endl;
+
+        return app_assembly_build_result::succeeded;
+#else
+        return app_assembly_build_result::up_to_date;
+#endif
+    }
+
+    bool script_engine::compile_app_assembly() {
+        app_assembly_build_t build;
+        if (!get_app_assembly_build(build)) {
+            return false;
+        }
+
+        // never build the project twice at once; whatever the background build produced is
+        // checked against the sources below
+        if (script_engine_data->compile_thread.joinable()) {
+            script_engine_data->compile_thread.join();
+        }
+
+        build_app_assembly(build);
+        return true;
+    }
+
+    bool script_engine::compile_app_assembly_async() {
+        if (script_engine_data->compiling) {
+            return false;
+        }
+
+        app_assembly_build_t build;
+        if (!get_app_assembly_build(build)) {
+            return false;
+        }
+
+        if (script_engine_data->compile_thread.joinable()) {
+            script_engine_data->compile_thread.join();
+        }
+
+        auto& app = application::get();
+        app.post_event(std::make_unique<script_compile_event>(script_compile_status::started));
+
+        auto compiling = &script_engine_data->compiling;
+        *compiling = true;
+
+        script_engine_data->compile_thread = std::thread([build, compiling]() {
+            using namespace std::chrono;
+            auto start = high_resolution_clock::now();
+
+            script_compile_status status;
+            switch (build_app_assembly(build)) {
+            case app_assembly_build_result::up_to_date:
+                status = script_compile_status::skipped;
+                break;
+            case app_assembly_build_result::succeeded:
+                status = script_compile_status::succeeded;
+                break;
+            default:
+                status = script_compile_status::failed;
+                break;
+            }
+
+            duration<double> time = high_resolution_clock::now() - start;
+            *compiling = false;
+
+            auto e = std::make_unique<script_compile_event>(status, time.count());
+            application::get().post_event(std::move(e));
+        });
+
         return true;
     }
 
+    bool script_engine::is_compiling() { return script_engine_data->compiling; }
+
     static std::optional<size_t> find_viable_assembly_index() {
         std::optional<size_t> index;
 
@@ -226,19 +525,53 @@ namespace sge {
             spdlog::warn("assembly does not exist: {0}", string_path);
             return false;
         } else {
-            MonoImageOpenStatus status;
+#ifdef SGE_MONO_AOT
+            // nothing can be jitted once the runtime is in aot mode
+            if (s_aot_enabled && !has_aot_image(path)) {
+                spdlog::error("{0} has no precompiled image and cannot be loaded", string_path);
+                return false;
+            }
+#endif
 
-            assembly.assembly = mono_assembly_open_full(string_path.c_str(), &status, false);
-            assembly.image = mono_assembly_get_image(assembly.assembly);
-            assembly.path = path;
+            // loaded from memory so that the file isn't locked while a new version is compiled
+            assembly.write_time = fs::last_write_time(path);
+            std::string data = read_file(path);
+
+            MonoImageOpenStatus status;
+            MonoImage* image = mono_image_open_from_data_with_name(
+                data.data(), (uint32_t)data.size(), true, &status, false, string_path.c_str());
 
             if (status != MONO_IMAGE_OK) {
                 std::string error_message = mono_image_strerror(status);
-                spdlog::warn("could not open {0}: ", string_path, error_message);
+                spdlog::warn("could not open {0}: {1}", string_path, error_message);
                 return false;
-            } else {
-                return true;
             }
+
+            fs::path symbols_path = path;
+            symbols_path.replace_extension(".pdb");
+
+            if (script_engine_data->debug_enabled && fs::exists(symbols_path)) {
+                std::string symbols = read_file(symbols_path);
+                mono_debug_open_image_from_memory(image, (const mono_byte*)symbols.data(),
+                                                  (int)symbols.size());
+            }
+
+            assembly.assembly =
+                mono_assembly_load_from_full(image, string_path.c_str(), &status, false);
+
+            // the assembly holds its own reference
+            mono_image_close(image);
+
+            if (assembly.assembly == nullptr || status != MONO_IMAGE_OK) {
+                std::string error_message = mono_image_strerror(status);
+                spdlog::warn("could not load {0}: {1}", string_path, error_message);
+                return false;
+            }
+
+            assembly.image = mono_assembly_get_image(assembly.assembly);
+            assembly.path = path;
+
+            return true;
         }
     }
 
@@ -333,6 +666,9 @@ namespace sge {
 
     enum class script_property_type { value, _entity, array, list, _asset };
     struct script_property_data_t {
+        std::string name;
+        size_t plan_index;
+
         value_wrapper data;
         std::vector<value_wrapper> array;
         void* array_element_type;
@@ -341,242 +677,396 @@ namespace sge {
         script_property_type property_type;
     };
 
-    // based on Hazel::ScriptEngine::ReloadAssembly
-    void script_engine::reload_assemblies(const std::vector<ref<scene>>& current_scenes,
-                                          const std::optional<std::function<bool()>>& pre_reload) {
-        std::vector<
-            std::unordered_map<guid, std::unordered_map<std::string, script_property_data_t>>>
-            old_property_values;
+    struct script_instance_data_t {
+        guid id;
+        std::vector<script_property_data_t> properties;
+    };
 
-        void* asset_class = script_helpers::get_core_type("SGE.Asset", true);
-        for (ref<scene> _scene : current_scenes) {
-            std::unordered_map<guid, std::unordered_map<std::string, script_property_data_t>>
-                entity_data;
+    // every instance of one script class within a scene
+    struct script_class_data_t {
+        uint64_t signature;
+        std::vector<script_instance_data_t> instances;
+    };
 
-            _scene->for_each<script_component>([&](entity e) {
-                auto& sc = e.get_component<script_component>();
-                if (!sc.instance || sc.instance->get() == nullptr) {
-                    return; // if the script isn't already initialized, theres nothing to save
-                }
+    static script_reload_stats s_reload_stats;
 
-                void* _class = sc._class;
-                void* instance = sc.instance->get();
+    static void hash_type(uint64_t& hash, MonoType* type) {
+        char* name = mono_type_get_name(type);
+        hash_string(hash, name);
+        mono_free(name);
+    }
 
-                std::vector<void*> properties;
-                iterate_properties(_class, properties);
+    // hashes everything the saved state of an instance depends on: the class name, its field
+    // layout, and its serialization plan. if two classes share a signature, saved properties can
+    // be restored by plan index
+    static uint64_t get_class_signature(void* _class) {
+        uint64_t hash = 0xcbf29ce484222325;
 
-                std::unordered_map<std::string, script_property_data_t> property_values;
-                for (void* property : properties) {
-                    if (!script_helpers::is_property_serializable(property)) {
-                        continue;
-                    }
+        class_name_t class_name;
+        script_engine::get_class_name(_class, class_name);
+        hash_string(hash, script_engine::get_string(class_name));
 
-                    script_property_data_t result;
-                    void* type = get_property_type(property);
-                    result.type_name = script_helpers::get_type_name_safe(type);
+        auto mono_class = (MonoClass*)_class;
+        hash_string(hash, std::to_string(mono_class_instance_size(mono_class)));
 
-                    void* property_data = get_property_value(instance, property);
-                    if (is_value_type(type)) {
-                        size_t size = script_helpers::get_type_size(type);
+        MonoClassField* field = nullptr;
+        void* iterator = nullptr;
+        while ((field = mono_class_get_fields(mono_class, &iterator)) != nullptr) {
+            hash_string(hash, mono_field_get_name(field));
+            hash_type(hash, mono_field_get_type(field));
+            hash_string(hash, std::to_string(mono_field_get_offset(field)));
+        }
 
-                        const void* unboxed = unbox_object(property_data);
-                        result.data = value_wrapper(unboxed, size);
+        for (const auto& property : script_helpers::get_serializable_properties(_class)) {
+            hash_string(hash, property.name);
+            hash_string(hash, property.type_name);
+        }
 
-                        result.property_type = script_property_type::value;
-                    } else {
-                        static const std::vector<std::string> list_type_names = {
-                            "System.Collections.Generic.IList",
-                            "System.Collections.Generic.IReadOnlyList",
-                            "System.Collections.Generic.List"
-                        };
-
-                        bool list = false;
-                        for (const auto& list_name : list_type_names) {
-                            if (result.type_name.substr(0, list_name.length()) == list_name) {
-                                list = true;
-                                break;
-                            }
-                        }
+        return hash;
+    }
 
-                        if (list) {
-                            void* object_type = get_class_from_object(property_data);
-                            void* count_property = get_property(object_type, "Count");
+    // scratch is reused across calls so that reading a backing field doesn't allocate
+    static bool save_property(void* instance, const serializable_property_t& property,
+                              void* asset_class, std::vector<uint8_t>& scratch,
+                              script_property_data_t& result) {
+        void* type = property.type;
+        result.name = property.name;
+        result.type_name = property.type_name;
 
-                            void* returned = get_property_value(property_data, count_property);
-                            int32_t count = unbox_object<int32_t>(returned);
+        if (property.value_type) {
+            if (property.backing_field != nullptr) {
+                scratch.resize(property.value_size);
+                script_engine::get_field_value(instance, property.backing_field, scratch.data());
 
-                            void* item_property = get_property(object_type, "Item");
-                            result.array_element_type = get_property_type(item_property);
-                            if (!is_value_type(result.array_element_type)) { // for now
-                                continue;
-                            }
+                result.data = value_wrapper(scratch.data(), scratch.size());
+            } else {
+                void* boxed = script_engine::get_property_value(instance, property.property);
+                const void* unboxed = script_engine::unbox_object(boxed);
 
-                            size_t item_size =
-                                script_helpers::get_type_size(result.array_element_type);
-                            for (int32_t i = 0; i < count; i++) {
-                                void* item = get_property_value(property_data, item_property, &i);
-                                const void* unboxed_data = unbox_object(item);
+                result.data = value_wrapper(unboxed, property.value_size);
+            }
 
-                                result.array.emplace_back(unboxed_data, item_size);
-                            }
+            result.property_type = script_property_type::value;
 
-                            result.property_type = script_property_type::list;
-                        } else if (result.type_name == "SGE.Entity") {
-                            if (property_data != nullptr) {
-                                entity e = script_helpers::get_entity_from_object(property_data);
-                                guid id = e.get_guid();
+            return true;
+        }
 
-                                result.data = value_wrapper(&id, sizeof(guid));
-                            }
+        void* property_data = script_engine::get_property_value(instance, property.property);
 
-                            result.property_type = script_property_type::_entity;
-                        } else if (script_helpers::type_is_array(type)) {
-                            result.array_element_type = get_array_element_type(property_data);
-                            if (!is_value_type(result.array_element_type)) {
-                                continue; // for now
-                            }
+        static const std::vector<std::string> list_type_names = {
+            "System.Collections.Generic.IList", "System.Collections.Generic.IReadOnlyList",
+            "System.Collections.Generic.List"
+        };
 
-                            size_t size = get_array_length(property_data);
-                            size_t element_size =
-                                script_helpers::get_type_size(result.array_element_type);
+        bool list = false;
+        for (const auto& list_name : list_type_names) {
+            if (result.type_name.substr(0, list_name.length()) == list_name) {
+                list = true;
+                break;
+            }
+        }
 
-                            for (size_t i = 0; i < size; i++) {
-                                void* boxed = get_array_element(property_data, i);
-                                const void* unboxed = unbox_object(boxed);
+        if (list) {
+            void* object_type = script_engine::get_class_from_object(property_data);
+            void* count_property = script_engine::get_property(object_type, "Count");
 
-                                result.array.emplace_back(unboxed, element_size);
-                            }
+            void* returned = script_engine::get_property_value(property_data, count_property);
+            int32_t count = script_engine::unbox_object<int32_t>(returned);
 
-                            result.property_type = script_property_type::array;
-                        } else if (script_helpers::type_extends(type, asset_class)) {
-                            auto _asset = script_helpers::get_asset_from_object(property_data);
-                            if (_asset) {
-                                result.data = value_wrapper(&_asset->id, sizeof(guid));
-                            }
+            void* item_property = script_engine::get_property(object_type, "Item");
+            result.array_element_type = script_engine::get_property_type(item_property);
+            if (!script_engine::is_value_type(result.array_element_type)) { // for now
+                return false;
+            }
 
-                            result.property_type = script_property_type::_asset;
-                        }
-                    }
+            size_t item_size = script_helpers::get_type_size(result.array_element_type);
+            for (int32_t i = 0; i < count; i++) {
+                void* item = script_engine::get_property_value(property_data, item_property, &i);
+                const void* unboxed_data = script_engine::unbox_object(item);
 
-                    std::string name = get_property_name(property);
-                    property_values.insert(std::make_pair(name, result));
-                }
+                result.array.emplace_back(unboxed_data, item_size);
+            }
 
+            result.property_type = script_property_type::list;
+        } else if (result.type_name == "SGE.Entity") {
+            if (property_data != nullptr) {
+                entity e = script_helpers::get_entity_from_object(property_data);
                 guid id = e.get_guid();
-                entity_data.insert(std::make_pair(id, property_values));
+
+                result.data = value_wrapper(&id, sizeof(guid));
+            }
+
+            result.property_type = script_property_type::_entity;
+        } else if (script_helpers::type_is_array(type)) {
+            result.array_element_type = script_engine::get_array_element_type(property_data);
+            if (!script_engine::is_value_type(result.array_element_type)) {
+                return false; // for now
+            }
+
+            size_t size = script_engine::get_array_length(property_data);
+            size_t element_size = script_helpers::get_type_size(result.array_element_type);
+
+            for (size_t i = 0; i < size; i++) {
+                void* boxed = script_engine::get_array_element(property_data, i);
+                const void* unboxed = script_engine::unbox_object(boxed);
+
+                result.array.emplace_back(unboxed, element_size);
+            }
+
+            result.property_type = script_property_type::array;
+        } else if (script_helpers::type_extends(type, asset_class)) {
+            auto _asset = script_helpers::get_asset_from_object(property_data);
+            if (_asset) {
+                result.data = value_wrapper(&_asset->id, sizeof(guid));
+            }
+
+            result.property_type = script_property_type::_asset;
+        }
+
+        return true;
+    }
+
+    static void restore_property(ref<scene> _scene, void* script_object,
+                                 const serializable_property_t& property,
+                                 const script_property_data_t& data) {
+        switch (data.property_type) {
+        case script_property_type::array: {
+            auto mono_element_type = (MonoClass*)data.array_element_type;
+            auto mono_array = mono_array_new(script_engine_data->script_domain,
+                                             mono_element_type, (uintptr_t)data.array.size());
+
+            for (size_t i = 0; i < data.array.size(); i++) {
+                const auto& value = data.array[i];
+                void* addr = mono_array_addr_with_size(mono_array, (int)value.size(), (uintptr_t)i);
+
+                memcpy(addr, value.ptr(), value.size());
+            }
+
+            script_engine::set_property_value(script_object, property.property, mono_array);
+        } break;
+        case script_property_type::_entity: {
+            void* entity_object = nullptr;
+            if (data.data) {
+                guid id = data.data.get<guid>();
+                entity value = _scene->find_guid(id);
+
+                entity_object = script_helpers::create_entity_object(value);
+            }
+
+            script_engine::set_property_value(script_object, property.property, entity_object);
+        } break;
+        case script_property_type::list: {
+            void* list = script_helpers::create_list_object(data.array_element_type);
+            void* list_type = script_engine::get_class_from_object(list);
+
+            void* add_method = script_engine::get_method(list_type, "Add");
+            for (const auto& element : data.array) {
+                script_engine::call_method(list, add_method, (void*)element.ptr());
+            }
+
+            script_engine::set_property_value(script_object, property.property, list);
+        } break;
+        case script_property_type::value:
+            if (property.backing_field != nullptr && property.value_size == data.data.size()) {
+                script_engine::set_field_value(script_object, property.backing_field,
+                                               (void*)data.data.ptr());
+            } else {
+                script_engine::set_property_value(script_object, property.property,
+                                                  (void*)data.data.ptr());
+            }
+            break;
+        case script_property_type::_asset: {
+            void* value = nullptr;
+            if (data.data) {
+                auto& manager = project::get().get_asset_manager();
+
+                guid id = data.data.get<guid>();
+                auto _asset = manager.get_asset(id);
+
+                value = script_helpers::create_asset_object(_asset);
+            }
+
+            script_engine::set_property_value(script_object, property.property, value);
+        } break;
+        }
+    }
+
+    // based on Hazel::ScriptEngine::ReloadAssembly
+    void script_engine::reload_assemblies(const std::vector<ref<scene>>& current_scenes,
+                                          const std::optional<std::function<bool()>>& pre_reload) {
+        using namespace std::chrono;
+        using milliseconds_t = duration<double, std::milli>;
+
+        s_reload_stats = script_reload_stats();
+        auto phase_start = high_resolution_clock::now();
+        auto end_phase = [&](double& time) {
+            auto now = high_resolution_clock::now();
+            time = milliseconds_t(now - phase_start).count();
+            phase_start = now;
+        };
+
+        std::vector<std::unordered_map<std::string, script_class_data_t>> old_class_data;
+        std::unordered_map<void*, uint64_t> old_signatures;
+        std::vector<uint8_t> value_scratch;
+
+        void* asset_class = script_helpers::get_core_type("SGE.Asset", true);
+        for (ref<scene> _scene : current_scenes) {
+            std::unordered_map<std::string, script_class_data_t> scene_data;
+
+            _scene->for_each<script_component>([&](entity e) {
+                auto& sc = e.get_component<script_component>();
+                if (!sc.instance || sc.instance->get() == nullptr) {
+                    return; // if the script isn't already initialized, theres nothing to save
+                }
+
+                void* _class = sc._class;
+                void* instance = sc.instance->get();
+
+                auto signature_it = old_signatures.find(_class);
+                if (signature_it == old_signatures.end()) {
+                    uint64_t signature = get_class_signature(_class);
+                    signature_it = old_signatures.insert(std::make_pair(_class, signature)).first;
+                }
+
+                auto& class_data = scene_data[sc.class_name];
+                class_data.signature = signature_it->second;
+
+                auto& instance_data = class_data.instances.emplace_back();
+                instance_data.id = e.get_guid();
+
+                const auto& properties = script_helpers::get_serializable_properties(_class);
+                instance_data.properties.reserve(properties.size());
+
+                for (size_t i = 0; i < properties.size(); i++) {
+                    auto& result = instance_data.properties.emplace_back();
+                    result.plan_index = i;
+
+                    if (!save_property(instance, properties[i], asset_class, value_scratch,
+                                       result)) {
+                        instance_data.properties.pop_back();
+                    }
+                }
+
+                s_reload_stats.instances++;
 
                 sc.instance.reset();
+                sc.methods = nullptr;
                 sc._class = nullptr;
             });
 
-            old_property_values.push_back(entity_data);
+            old_class_data.push_back(std::move(scene_data));
+
+            // wrappers from the old domain can't outlive it
+            _scene->release_managed_objects();
         }
 
+        end_phase(s_reload_stats.save_time);
         reinitialize_script_engine(pre_reload);
-        for (size_t scene_index = 0; scene_index < old_property_values.size(); scene_index++) {
-            auto _scene = current_scenes[scene_index];
-            const auto& entity_map = old_property_values[scene_index];
+        end_phase(s_reload_stats.reload_time);
 
-            for (const auto& [entity_id, property_values] : entity_map) {
-                entity current_entity = _scene->find_guid(entity_id);
-                if (!current_entity) {
-                    continue;
-                }
+        std::unordered_map<std::string, void*> new_classes;
+        std::unordered_set<std::string> counted_classes;
+        for (size_t scene_index = 0; scene_index < old_class_data.size(); scene_index++) {
+            auto _scene = current_scenes[scene_index];
+            const auto& scene_data = old_class_data[scene_index];
+
+            for (const auto& [class_name, class_data] : scene_data) {
+                auto class_it = new_classes.find(class_name);
+                if (class_it == new_classes.end()) {
+                    void* found_class = nullptr;
+                    for (const auto& assembly : script_engine_data->assemblies) {
+                        if (assembly.image == nullptr) {
+                            continue;
+                        }
 
-                auto& sc = current_entity.get_component<script_component>();
-                for (const auto& assembly : script_engine_data->assemblies) {
-                    if (assembly.image == nullptr) {
-                        continue;
+                        found_class = get_class(assembly.image, class_name);
+                        if (found_class != nullptr) {
+                            break;
+                        }
                     }
 
-                    void* _class = get_class(assembly.image, sc.class_name);
-                    if (_class != nullptr) {
-                        sc._class = _class;
-                        break;
-                    }
+                    class_it = new_classes.insert(std::make_pair(class_name, found_class)).first;
                 }
 
-                if (sc._class == nullptr) {
-                    spdlog::warn(
-                        "between reloads, script class {0} was deleted - deleting script data",
-                        sc.class_name);
+                void* _class = class_it->second;
+                bool first_occurrence = counted_classes.insert(class_name).second;
+
+                if (_class == nullptr) {
+                    if (first_occurrence) {
+                        spdlog::warn(
+                            "between reloads, script class {0} was deleted - deleting script data",
+                            class_name);
+
+                        s_reload_stats.deleted_classes++;
+                    }
 
                     continue;
                 }
 
-                sc.verify_script(current_entity);
-                void* script_object = sc.instance->get();
-
-                for (const auto& [property_name, data] : property_values) {
-                    void* property = get_property(sc._class, property_name);
-                    if (property == nullptr) {
-                        spdlog::warn("between reloads, script property {0}.{1} was deleted - "
-                                     "deleting its data",
-                                     sc.class_name, property_name);
+                // if nothing the saved state depends on has changed, properties line up with the
+                // new plan and don't need to be looked up by name
+                bool unchanged = get_class_signature(_class) == class_data.signature;
+                if (first_occurrence) {
+                    if (unchanged) {
+                        s_reload_stats.unchanged_classes++;
+                    } else {
+                        s_reload_stats.changed_classes++;
+                    }
+                }
 
+                const auto& properties = script_helpers::get_serializable_properties(_class);
+                for (const auto& instance_data : class_data.instances) {
+                    entity current_entity = _scene->find_guid(instance_data.id);
+                    if (!current_entity) {
                         continue;
                     }
 
-                    switch (data.property_type) {
-                    case script_property_type::array: {
-                        auto mono_element_type = (MonoClass*)data.array_element_type;
-                        auto mono_array =
-                            mono_array_new(script_engine_data->script_domain, mono_element_type,
-                                           (uintptr_t)data.array.size());
+                    auto& sc = current_entity.get_component<script_component>();
+                    sc._class = _class;
 
-                        for (size_t i = 0; i < data.array.size(); i++) {
-                            const auto& value = data.array[i];
-                            void* addr = mono_array_addr_with_size(mono_array, (int)value.size(),
-                                                                   (uintptr_t)i);
+                    sc.verify_script(current_entity);
+                    void* script_object = sc.instance->get();
 
-                            memcpy(addr, value.ptr(), value.size());
-                        }
+                    for (const auto& data : instance_data.properties) {
+                        if (unchanged) {
+                            restore_property(_scene, script_object, properties[data.plan_index],
+                                             data);
 
-                        set_property_value(script_object, property, mono_array);
-                    } break;
-                    case script_property_type::_entity: {
-                        void* entity_object = nullptr;
-                        if (data.data) {
-                            guid id = data.data.get<guid>();
-                            entity value = _scene->find_guid(id);
+                            continue;
+                        }
 
-                            entity_object = script_helpers::create_entity_object(value);
+                        const serializable_property_t* property = nullptr;
+                        for (const auto& current : properties) {
+                            if (current.name == data.name) {
+                                property = &current;
+                                break;
+                            }
                         }
 
-                        set_property_value(script_object, property, entity_object);
-                    } break;
-                    case script_property_type::list: {
-                        void* list = script_helpers::create_list_object(data.array_element_type);
-                        void* list_type = get_class_from_object(list);
+                        if (property == nullptr) {
+                            spdlog::warn("between reloads, script property {0}.{1} was deleted - "
+                                         "deleting its data",
+                                         class_name, data.name);
 
-                        void* add_method = get_method(list_type, "Add");
-                        for (const auto& element : data.array) {
-                            call_method(list, add_method, (void*)element.ptr());
+                            continue;
                         }
 
-                        set_property_value(script_object, property, list);
-                    } break;
-                    case script_property_type::value:
-                        set_property_value(script_object, property, (void*)data.data.ptr());
-                        break;
-                    case script_property_type::_asset: {
-                        void* value = nullptr;
-                        if (data.data) {
-                            auto& manager = project::get().get_asset_manager();
-
-                            guid id = data.data.get<guid>();
-                            auto _asset = manager.get_asset(id);
+                        if (property->type_name != data.type_name) {
+                            spdlog::warn("between reloads, script property {0}.{1} changed type - "
+                                         "deleting its data",
+                                         class_name, data.name);
 
-                            value = script_helpers::create_asset_object(_asset);
+                            continue;
                         }
 
-                        set_property_value(script_object, property, value);
-                    } break;
+                        restore_property(_scene, script_object, *property, data);
                     }
                 }
             }
         }
 
+        end_phase(s_reload_stats.restore_time);
+
         script_engine_data->reload_callbacks_locked = true;
         for (const auto& callback : script_engine_data->reload_callbacks) {
             if (callback.has_value()) {
@@ -585,8 +1075,19 @@ namespace sge {
         }
 
         script_engine_data->reload_callbacks_locked = false;
+        end_phase(s_reload_stats.callback_time);
+
+        spdlog::info("reloaded assemblies: {0} instances, {1} unchanged classes, {2} changed, "
+                     "{3} deleted - save {4:.1f}ms, reload {5:.1f}ms, restore {6:.1f}ms, "
+                     "callbacks {7:.1f}ms",
+                     s_reload_stats.instances, s_reload_stats.unchanged_classes,
+                     s_reload_stats.changed_classes, s_reload_stats.deleted_classes,
+                     s_reload_stats.save_time, s_reload_stats.reload_time,
+                     s_reload_stats.restore_time, s_reload_stats.callback_time);
     }
 
+    const script_reload_stats& script_engine::get_reload_stats() { return s_reload_stats; }
+
     size_t script_engine::add_on_reload_callback(const std::function<void()>& callback) {
         if (script_engine_data->reload_callbacks_locked) {
             throw std::runtime_error("reload callbacks have been locked!");
@@ -636,6 +1137,19 @@ namespace sge {
         return assembly_path;
     }
 
+    bool script_engine::is_assembly_outdated(size_t index) {
+        if (index >= script_engine_data->assemblies.size()) {
+            return false;
+        }
+
+        const auto& data = script_engine_data->assemblies[index];
+        if (data.assembly == nullptr || !fs::exists(data.path)) {
+            return false;
+        }
+
+        return fs::last_write_time(data.path) > data.write_time;
+    }
+
     std::string script_engine::get_assembly_name(void* assembly) {
         auto mono_image = (MonoImage*)assembly;
         auto mono_assembly = mono_image_get_assembly(mono_image);
@@ -726,6 +1240,11 @@ namespace sge {
         return mono_class_is_valuetype(mono_class);
     }
 
+    size_t script_engine::get_value_size(void* _class) {
+        auto mono_class = (MonoClass*)_class;
+        return (size_t)mono_class_value_size(mono_class, nullptr);
+    }
+
     void* script_engine::alloc_object(void* _class) {
         auto mono_class = (MonoClass*)_class;
 
@@ -750,6 +1269,11 @@ namespace sge {
         mono_runtime_object_init(mono_object);
     }
 
+    void* script_engine::box_object(void* _class, const void* data) {
+        auto mono_class = (MonoClass*)_class;
+        return mono_value_box(script_engine_data->script_domain, mono_class, (void*)data);
+    }
+
     const void* script_engine::unbox_object(void* object) {
         auto mono_object = (MonoObject*)object;
         return mono_object_unbox(mono_object);
@@ -784,6 +1308,28 @@ namespace sge {
         }
     }
 
+    void* script_engine::get_array_data(void* array) {
+        void* array_type = get_class_from_object(array);
+        auto mono_class = (MonoClass*)array_type;
+
+        auto mono_array = (MonoArray*)array;
+        int32_t element_size = mono_array_element_size(mono_class);
+        return mono_array_addr_with_size(mono_array, element_size, 0);
+    }
+
+    void* script_engine::create_array(void* element_type, size_t length) {
+        auto mono_class = (MonoClass*)element_type;
+        return mono_array_new(script_engine_data->script_domain, mono_class, (uintptr_t)length);
+    }
+
+    void script_engine::set_array_element(void* array, size_t index, void* object) {
+        auto mono_array = (MonoArray*)array;
+        auto mono_object = (MonoObject*)object;
+
+        // reference type elements need the write barrier
+        mono_array_setref(mono_array, (uintptr_t)index, mono_object);
+    }
+
     void* script_engine::get_method(void* _class, const std::string& name) {
         std::string method_desc = "*:" + name;
         auto mono_desc = mono_method_desc_new(method_desc.c_str(), false);
@@ -792,6 +1338,34 @@ namespace sge {
         return mono_method_desc_search_in_class(mono_desc, mono_class);
     }
 
+    const script_methods_t& script_engine::get_script_methods(void* _class) {
+        auto& cache = script_engine_data->script_methods;
+
+        auto it = cache.find(_class);
+        if (it == cache.end()) {
+            script_methods_t methods;
+            methods._class = _class;
+
+            methods.on_start = get_method(_class, "OnStart()");
+            methods.on_stop = get_method(_class, "OnStop()");
+            methods.on_update = get_method(_class, "OnUpdate(Timestep)");
+            methods.on_fixed_update = get_method(_class, "OnFixedUpdate(Timestep)");
+            methods.on_event = get_method(_class, "OnEvent(Event)");
+            methods.on_collision = get_method(_class, "OnCollision(Entity)");
+            methods.on_collision_end = get_method(_class, "OnCollisionEnd(Entity)");
+
+            methods.on_update_thunk = get_method_thunk(methods.on_update);
+            methods.on_fixed_update_thunk = get_method_thunk(methods.on_fixed_update);
+            methods.on_event_thunk = get_method_thunk(methods.on_event);
+            methods.on_collision_thunk = get_method_thunk(methods.on_collision);
+            methods.on_collision_end_thunk = get_method_thunk(methods.on_collision_end);
+
+            it = cache.insert(std::make_pair(_class, methods)).first;
+        }
+
+        return it->second;
+    }
+
     std::string script_engine::get_method_name(void* method) {
         auto mono_method = (MonoMethod*)method;
         return mono_method_get_name(mono_method);
@@ -907,6 +1481,29 @@ namespace sge {
         return returned;
     }
 
+    using object_thunk_t = void(SGE_THUNK_CALL*)(MonoObject*, MonoObject*, MonoException**);
+
+    void* script_engine::get_method_thunk(void* method) {
+        if (method == nullptr) {
+            return nullptr;
+        }
+
+        auto mono_method = (MonoMethod*)method;
+        return mono_method_get_unmanaged_thunk(mono_method);
+    }
+
+    void script_engine::call_thunk(void* thunk, void* object, void* argument) {
+        if (thunk == nullptr) {
+            throw std::runtime_error("attempted to call nullptr!");
+        }
+
+        MonoException* exc = nullptr;
+        auto function = (object_thunk_t)thunk;
+
+        function((MonoObject*)object, (MonoObject*)argument, &exc);
+        handle_exception(exc);
+    }
+
     void script_engine::handle_exception(void* exception) {
         if (exception != nullptr) {
             script_helpers::report_exception(exception);
@@ -1066,6 +1663,13 @@ namespace sge {
                                            mono_object);
     }
 
+    void script_engine::get_field_value(void* object, void* field, void* data) {
+        auto mono_object = (MonoObject*)object;
+        auto mono_field = (MonoClassField*)field;
+
+        mono_field_get_value(mono_object, mono_field, data);
+    }
+
     void script_engine::set_field_value(void* object, void* field, void* value) {
         auto mono_object = (MonoObject*)object;
         auto mono_field = (MonoClassField*)field;
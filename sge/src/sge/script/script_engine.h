@@ -27,6 +27,41 @@ namespace sge {
         void* type;
     };
 
+    // engine callbacks of a script class, resolved once per class. methods that the class
+    // doesn't define are null
+    struct script_methods_t {
+        void* _class = nullptr;
+
+        void* on_start = nullptr;
+        void* on_stop = nullptr;
+        void* on_update = nullptr;
+        void* on_fixed_update = nullptr;
+        void* on_event = nullptr;
+        void* on_collision = nullptr;
+        void* on_collision_end = nullptr;
+
+        // unmanaged thunks of the per-frame callbacks; see script_engine::call_thunk
+        void* on_update_thunk = nullptr;
+        void* on_fixed_update_thunk = nullptr;
+        void* on_event_thunk = nullptr;
+        void* on_collision_thunk = nullptr;
+        void* on_collision_end_thunk = nullptr;
+    };
+
+    // counts and per-phase timings of the most recent script_engine::reload_assemblies call.
+    // times are in milliseconds
+    struct script_reload_stats {
+        size_t instances = 0;
+        size_t unchanged_classes = 0;
+        size_t changed_classes = 0;
+        size_t deleted_classes = 0;
+
+        double save_time = 0.0;
+        double reload_time = 0.0;
+        double restore_time = 0.0;
+        double callback_time = 0.0;
+    };
+
     enum property_accessor_flags {
         property_accessor_none = 0x0,
         property_accessor_get = 0x1,
@@ -68,6 +103,11 @@ namespace sge {
         static void init();
         static void shutdown();
 
+        // whether to run the precompiled images built with SGE_MONO_AOT. must be set before
+        // init; the editor never uses them
+        static void set_aot_enabled(bool enabled);
+        static bool is_aot_enabled();
+
         static void register_call_group(const std::string& managed_group_id,
                                         const std::function<void(function_registerer&)>& callback);
 
@@ -76,16 +116,26 @@ namespace sge {
 
         static bool compile_app_assembly();
 
+        // compiles the app assembly on a background thread, posting script_compile_events to the
+        // application. returns false if there is no script project or a compile is running
+        static bool compile_app_assembly_async();
+        static bool is_compiling();
+
         static std::optional<size_t> load_assembly(const fs::path& path);
         static bool unload_assembly(size_t index);
         static void reload_assemblies(const std::vector<ref<scene>>& current_scenes,
                                       const std::optional<std::function<bool()>>& pre_reload = {});
 
+        static const script_reload_stats& get_reload_stats();
+
         static size_t add_on_reload_callback(const std::function<void()>& callback);
         static bool remove_on_reload_callback(size_t index);
 
         static size_t get_assembly_count();
         static fs::path get_assembly_path(size_t index);
+
+        // true if the file has been written since the assembly was loaded
+        static bool is_assembly_outdated(size_t index);
         static std::string get_assembly_name(void* assembly);
 
         static void* get_assembly(size_t index);
@@ -103,9 +153,13 @@ namespace sge {
 
         static bool is_value_type(void* _class);
 
+        // the size of an unboxed value, as laid out by the runtime
+        static size_t get_value_size(void* _class);
+
         static void* alloc_object(void* _class);
         static void* clone_object(void* original);
         static void init_object(void* object);
+        static void* box_object(void* _class, const void* data);
         static const void* unbox_object(void* object);
 
         template <typename T>
@@ -117,8 +171,14 @@ namespace sge {
         static size_t get_array_length(void* array);
         static void* get_array_element_type(void* array);
         static void* get_array_element(void* array, size_t index);
+        static void* get_array_data(void* array);
+        static void* create_array(void* element_type, size_t length);
+        static void set_array_element(void* array, size_t index, void* object);
 
         static void* get_method(void* _class, const std::string& name);
+
+        // the returned table is valid until assemblies are reloaded
+        static const script_methods_t& get_script_methods(void* _class);
         static std::string get_method_name(void* method);
         static void* get_method_return_type(void* method);
         static uint32_t get_method_visibility(void* method);
@@ -132,20 +192,26 @@ namespace sge {
 
         template <typename... Args>
         static void* call_method(void* object, void* method, Args*... args) {
-            std::vector<void*> args_vector = { std::forward<Args*>(args)... };
-            void** arguments = args_vector.empty() ? nullptr : args_vector.data();
+            std::array<void*, sizeof...(Args)> args_array = { args... };
+            void** arguments = args_array.empty() ? nullptr : args_array.data();
 
             return call_method(object, method, arguments);
         }
         
         template <typename... Args>
         static void* call_delegate(void* delegate, Args*... args) {
-            std::vector<void*> args_vector = { std::forward<Args*>(args)... };
-            void** arguments = args_vector.empty() ? nullptr : args_vector.data();
+            std::array<void*, sizeof...(Args)> args_array = { args... };
+            void** arguments = args_array.empty() ? nullptr : args_array.data();
 
             return call_delegate(delegate, arguments);
         }
 
+        // Thunks call a method directly instead of through the runtime's invoke path. Only void
+        // instance methods taking a single argument are supported. Value type arguments are
+        // passed boxed; the thunk copies the value out, so one box can be shared between calls.
+        static void* get_method_thunk(void* method);
+        static void call_thunk(void* thunk, void* object, void* argument);
+
         static void* get_property(void* _class, const std::string& name);
         static void iterate_properties(void* _class, std::vector<void*>& properties);
 
@@ -188,6 +254,7 @@ namespace sge {
         }
 
         static void* get_field_value(void* object, void* field);
+        static void get_field_value(void* object, void* field, void* data);
         static void set_field_value(void* object, void* field, void* value);
     };
 } // namespace sge
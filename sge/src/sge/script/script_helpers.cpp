@@ -125,6 +125,10 @@ namespace sge {
             return nullptr;
         }
 
+        return e.get_scene()->get_managed_object(e);
+    }
+
+    void* script_helpers::alloc_scene_object(scene* _scene) {
         void* scriptcore = script_engine::get_assembly(0);
         void* scene_class = script_engine::get_class(scriptcore, "SGE.Scene");
         if (scene_class == nullptr) {
@@ -136,11 +140,13 @@ namespace sge {
             throw std::runtime_error("could not find the Scene object constructor!");
         }
 
-        scene* _scene = e.get_scene();
-
         void* scene_instance = script_engine::alloc_object(scene_class);
         script_engine::call_method(scene_instance, scene_constructor, &_scene);
+        return scene_instance;
+    }
 
+    void* script_helpers::alloc_entity_object(entity e, void* scene_object) {
+        void* scriptcore = script_engine::get_assembly(0);
         void* entity_class = script_engine::get_class(scriptcore, "SGE.Entity");
         if (entity_class == nullptr) {
             throw std::runtime_error("could not find SGE.Entity!");
@@ -154,7 +160,7 @@ namespace sge {
         uint32_t id = (uint32_t)e;
 
         void* entity_instance = script_engine::alloc_object(entity_class);
-        script_engine::call_method(entity_instance, entity_constructor, &id, scene_instance);
+        script_engine::call_method(entity_instance, entity_constructor, &id, scene_object);
         return entity_instance;
     }
 
@@ -274,6 +280,16 @@ namespace sge {
         return script_engine::call_method(nullptr, method, &ptr, &id);
     }
 
+    void* script_helpers::create_script_dispatcher(void* _class, const std::string& method_name) {
+        void* dispatcher_class = get_core_type("SGE.ScriptDispatcher", true);
+        void* method = script_engine::get_method(dispatcher_class, "Create");
+
+        void* reflection_type = script_engine::to_reflection_type(_class);
+        void* name = script_engine::to_managed_string(method_name);
+
+        return script_engine::call_method(nullptr, method, reflection_type, name);
+    }
+
     void* script_helpers::create_list_object(void* element_type) {
         void* method = script_engine::get_method(managed_helpers_class, "CreateListObject");
         void* reflection_type = script_engine::to_reflection_type(element_type);
@@ -22,6 +22,22 @@
 #include "sge/script/garbage_collector.h"
 
 namespace sge {
+    // a serializable property of a script class, with the reflection data needed to save it
+    struct serializable_property_t {
+        void* property;
+        std::string name;
+
+        void* type;
+        std::string type_name;
+
+        bool read_only, is_enum, value_type;
+        size_t value_size;
+
+        // the compiler-generated field behind an auto-property of a value type. values are
+        // copied through it directly, without boxing or calling the accessors
+        void* backing_field;
+    };
+
     class script_helpers {
     public:
         script_helpers() = delete;
@@ -40,9 +56,14 @@ namespace sge {
         static bool is_property_serializable(void* property);
         static bool is_property_read_only(void* property);
 
+        // returns the wrapper cached by the entity's scene, creating it if needed
         static void* create_entity_object(entity e);
         static entity get_entity_from_object(void* object);
 
+        // always allocates a new wrapper
+        static void* alloc_scene_object(scene* _scene);
+        static void* alloc_entity_object(entity e, void* scene_object);
+
         static void* create_asset_object(ref<asset> _asset);
         static ref<asset> get_asset_from_object(void* object);
 
@@ -58,12 +79,22 @@ namespace sge {
         static void* create_event_object(event& e);
         static void* create_list_object(void* element_type);
 
+        // null if the class has no suitable method
+        static void* create_script_dispatcher(void* _class, const std::string& method_name);
+
         static void set_editor_scene(ref<scene> _scene);
         static void show_property_control(void* instance, void* property, const std::string& label);
 
         static void serialize_property(void* instance, void* property, json& data);
         static void deserialize_property(void* instance, void* property, const json& data);
 
+        // built once per class from reflection, and dropped when the script domain is reloaded
+        static const std::vector<serializable_property_t>& get_serializable_properties(
+            void* _class);
+
+        static void serialize_properties(void* instance, void* _class, json& data);
+        static void deserialize_properties(void* instance, void* _class, const json& data);
+
     private:
         static void register_property_handlers();
     };
@@ -44,6 +44,11 @@ namespace sgm {
     }
 
     void editor_layer::on_update(timestep ts) {
+        if (m_assembly_load_pending && !editor_scene::running()) {
+            m_assembly_load_pending = false;
+            load_project_assembly(false);
+        }
+
         for (auto& _panel : m_panels) {
             _panel->update(ts);
         }
@@ -54,6 +59,8 @@ namespace sgm {
     void editor_layer::on_event(event& e) {
         event_dispatcher dispatcher(e);
         dispatcher.dispatch<key_pressed_event>(SGE_BIND_EVENT_FUNC(editor_layer::on_key));
+        dispatcher.dispatch<script_compile_event>(
+            SGE_BIND_EVENT_FUNC(editor_layer::on_script_compile));
 
         if (!e.handled) {
             editor_scene::on_event(e);
@@ -404,7 +411,45 @@ namespace sgm {
         }
     }
 
+    bool editor_layer::on_script_compile(script_compile_event& e) {
+        switch (e.get_status()) {
+        case script_compile_status::started:
+            spdlog::info("compiling scripts...");
+            break;
+        case script_compile_status::skipped: {
+            spdlog::info("scripts are up to date");
+
+            // the sources haven't changed, but the assembly may have been built elsewhere
+            auto index = project::get().get_assembly_index();
+            if (!index.has_value() || script_engine::is_assembly_outdated(index.value())) {
+                m_assembly_load_pending = true;
+            }
+        } break;
+        case script_compile_status::succeeded:
+            spdlog::info("scripts compiled in {0:.2f}s", e.get_time());
+            m_assembly_load_pending = true;
+            break;
+        case script_compile_status::failed:
+            spdlog::error("failed to compile scripts - keeping the current assembly");
+            break;
+        }
+
+        return true;
+    }
+
     void editor_layer::reload_project_assembly() {
+        if (script_engine::is_compiling()) {
+            spdlog::info("scripts are already being compiled");
+            return;
+        }
+
+        // the assembly is loaded once the compile finishes
+        if (!script_engine::compile_app_assembly_async()) {
+            load_project_assembly(true);
+        }
+    }
+
+    void editor_layer::load_project_assembly(bool compile) {
         for (const auto& panel_ : m_panels) {
             if (panel_->get_id() == panel_id::editor) {
                 auto editor = (editor_panel*)panel_.get();
@@ -415,7 +460,7 @@ namespace sgm {
         }
 
         auto _scene = editor_scene::get_scene();
-        project::reload_assembly({ _scene });
+        project::reload_assembly({ _scene }, compile);
     }
 
     void editor_layer::new_scene() {
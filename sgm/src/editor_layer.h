@@ -36,6 +36,7 @@ namespace sgm {
         }
 
         bool on_key(key_pressed_event& e);
+        bool on_script_compile(script_compile_event& e);
 
         void register_popups();
 
@@ -44,6 +45,7 @@ namespace sgm {
         void update_menu_bar();
 
         void reload_project_assembly();
+        void load_project_assembly(bool compile);
         void new_scene();
         void open();
         void save_as();
@@ -52,5 +54,8 @@ namespace sgm {
         std::vector<std::unique_ptr<panel>> m_panels;
         std::optional<fs::path> m_scene_path;
         popup_manager m_popup_manager;
+
+        // set once a compile finishes; the assembly is loaded when the scene isn't running
+        bool m_assembly_load_pending = false;
     };
 } // namespace sgm
\ No newline at end of file
@@ -134,12 +134,16 @@ namespace sgm {
 
         draw_component<transform_component>(
             "Transform", selection, [selection](transform_component& transform) {
-                ImGui::DragFloat2("Translation", &transform.translation.x, 0.25f);
-                ImGui::DragFloat("Rotation", &transform.rotation);
-                ImGui::DragFloat2("Scale", &transform.scale.x, 0.5f);
+                bool changed = ImGui::DragFloat2("Translation", &transform.translation.x, 0.25f);
+                changed |= ImGui::DragFloat("Rotation", &transform.rotation);
+                changed |= ImGui::DragFloat2("Scale", &transform.scale.x, 0.5f);
+
+                if (changed) {
+                    selection.get_scene()->update_physics_data(selection);
+                }
 
                 if (ImGui::InputInt("Z layer", &transform.z_layer)) {
-                    selection.get_scene()->recalculate_render_order();
+                    selection.get_scene()->update_render_order(selection);
                 }
             });
 
@@ -193,61 +197,73 @@ namespace sgm {
                 ref<asset> _asset = component.texture;
                 if (ImGui::InputAsset("Texture", &_asset, "texture", "texture_2d")) {
                     component.texture = _asset.as<texture_2d>();
+                    selection.get_scene()->update_render_order(selection);
                 }
 
                 static const std::string shader_name = "shader";
                 _asset = component._shader;
                 if (ImGui::InputAsset("Shader", &_asset, shader_name, shader_name)) {
                     component._shader = _asset.as<shader>();
-                    selection.get_scene()->recalculate_render_order();
+                    selection.get_scene()->update_render_order(selection);
                 }
             });
 
-        draw_component<
-            rigid_body_component>("Rigid body", selection, [this](rigid_body_component& component) {
-            static const std::vector<const char*> type_names = { "Static", "Kinematic", "Dynamic" };
-            int32_t type_index = (int32_t)component.type;
-            if (ImGui::Combo("Body type", &type_index, type_names.data(), type_names.size())) {
-                component.type = (rigid_body_component::body_type)type_index;
-            }
+        draw_component<rigid_body_component>(
+            "Rigid body", selection, [this, selection](rigid_body_component& component) {
+                static const std::vector<const char*> type_names = { "Static", "Kinematic",
+                                                                     "Dynamic" };
+                int32_t type_index = (int32_t)component.type;
+                if (ImGui::Combo("Body type", &type_index, type_names.data(), type_names.size())) {
+                    component.type = (rigid_body_component::body_type)type_index;
+                    selection.get_scene()->update_physics_data(selection);
+                }
 
-            ImGui::Checkbox("Fixed rotation", &component.fixed_rotation);
+                if (ImGui::Checkbox("Fixed rotation", &component.fixed_rotation)) {
+                    selection.get_scene()->update_physics_data(selection);
+                }
 
-            if (ImGui::CollapsingHeader("Collision filter")) {
-                ImGui::Indent();
-                bool editor_open = m_popup_manager->is_open(collision_filter_editor_name);
+                if (ImGui::CollapsingHeader("Collision filter")) {
+                    ImGui::Indent();
+                    bool editor_open = m_popup_manager->is_open(collision_filter_editor_name);
 
-                ImGui::Text("Category");
-                ImGui::SameLine();
+                    ImGui::Text("Category");
+                    ImGui::SameLine();
 
-                if (ImGui::Button("Edit##category-edit-button") && !editor_open) {
-                    m_filter_editor_data.type = filter_editor_type::category;
-                    m_filter_editor_data.field = &component.filter_category;
+                    if (ImGui::Button("Edit##category-edit-button") && !editor_open) {
+                        m_filter_editor_data.type = filter_editor_type::category;
+                        m_filter_editor_data.field = &component.filter_category;
+                        m_filter_editor_data.owner = selection;
 
-                    m_popup_manager->open(collision_filter_editor_name);
-                }
+                        m_popup_manager->open(collision_filter_editor_name);
+                    }
 
-                ImGui::Text("Mask");
-                ImGui::SameLine();
+                    ImGui::Text("Mask");
+                    ImGui::SameLine();
 
-                if (ImGui::Button("Edit##mask-edit-button") && !editor_open) {
-                    m_filter_editor_data.type = filter_editor_type::mask;
-                    m_filter_editor_data.field = &component.filter_mask;
+                    if (ImGui::Button("Edit##mask-edit-button") && !editor_open) {
+                        m_filter_editor_data.type = filter_editor_type::mask;
+                        m_filter_editor_data.field = &component.filter_mask;
+                        m_filter_editor_data.owner = selection;
 
-                    m_popup_manager->open(collision_filter_editor_name);
-                }
+                        m_popup_manager->open(collision_filter_editor_name);
+                    }
 
-                ImGui::Unindent();
-            }
-        });
+                    ImGui::Unindent();
+                }
+            });
 
         draw_component<box_collider_component>(
-            "Box collider", selection, [this](box_collider_component& component) {
-                ImGui::DragFloat("Density", &component.density, 0.1f);
-                ImGui::DragFloat("Friction", &component.friction, 0.1f);
-                ImGui::DragFloat("Restitution", &component.restitution, 0.1f);
-                ImGui::DragFloat("Restitution threashold", &component.restitution_threashold, 0.1f);
-                ImGui::DragFloat2("Size", &component.size.x, 0.01f);
+            "Box collider", selection, [this, selection](box_collider_component& component) {
+                bool changed = ImGui::DragFloat("Density", &component.density, 0.1f);
+                changed |= ImGui::DragFloat("Friction", &component.friction, 0.1f);
+                changed |= ImGui::DragFloat("Restitution", &component.restitution, 0.1f);
+                changed |= ImGui::DragFloat("Restitution threashold",
+                                            &component.restitution_threashold, 0.1f);
+                changed |= ImGui::DragFloat2("Size", &component.size.x, 0.01f);
+
+                if (changed) {
+                    selection.get_scene()->update_physics_data(selection);
+                }
             });
 
         draw_component<script_component>(
@@ -335,6 +351,9 @@ namespace sgm {
                         } else {
                             field &= ~bit;
                         }
+
+                        entity owner = m_filter_editor_data.owner;
+                        owner.get_scene()->update_physics_data(owner);
                     }
 
                     std::string& category_label = _scene->collision_category_name(i);
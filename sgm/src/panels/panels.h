@@ -81,6 +81,7 @@ namespace sgm {
         struct filter_editor_data_t {
             filter_editor_type type;
             uint16_t* field;
+            entity owner;
         };
 
         struct section_header_t {
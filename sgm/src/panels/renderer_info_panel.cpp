@@ -21,10 +21,8 @@
 namespace sgm {
     void renderer_info_panel::update(timestep ts) {
         if (m_reload_shaders) {
-            renderer::wait();
-
             auto& library = renderer::get_shader_library();
-            library.reload_all();
+            library.reload_all_async();
 
             m_reload_shaders = false;
         }
@@ -38,6 +36,11 @@ namespace sgm {
             m_reload_shaders = true;
         }
 
+        bool instancing = renderer::is_instancing_enabled();
+        if (ImGui::Checkbox("Instanced quads", &instancing)) {
+            renderer::set_instancing_enabled(instancing);
+        }
+
         if (ImGui::CollapsingHeader("Renderer stats")) {
             renderer::stats stats = renderer::get_stats();
 
@@ -45,6 +48,36 @@ namespace sgm {
             ImGui::Text("Quads: %u", stats.quad_count);
             ImGui::Text("Vertices: %u", stats.vertex_count);
             ImGui::Text("Indices: %u", stats.index_count);
+            ImGui::Text("Instances: %u", stats.instance_count);
+
+            float ring_usage = 0.f;
+            if (stats.vertex_ring_capacity > 0) {
+                ring_usage = (float)stats.vertex_ring_used / (float)stats.vertex_ring_capacity;
+            }
+
+            ImGui::Text("Vertex ring: %zu/%zu bytes (%.1f%%)", stats.vertex_ring_used,
+                        stats.vertex_ring_capacity, ring_usage * 100.f);
+            ImGui::Text("Vertex ring overflows: %u", stats.vertex_ring_overflows);
+        }
+
+        if (application::get().is_subsystem_initialized(subsystem_script_engine) &&
+            ImGui::CollapsingHeader("Garbage collector")) {
+            auto& settings = garbage_collector::get_settings();
+            ImGui::Checkbox("Scheduled collections", &settings.scheduled);
+
+            float growth_threshold = (float)settings.heap_growth_threshold;
+            if (ImGui::DragFloat("Heap growth threshold", &growth_threshold, 0.05f, 1.f, 16.f)) {
+                settings.heap_growth_threshold = (double)growth_threshold;
+            }
+
+            const auto& stats = garbage_collector::get_frame_stats();
+            ImGui::Text("Minor collections: %u", stats.minor_collections);
+            ImGui::Text("Major collections: %u", stats.major_collections);
+            ImGui::Text("Pause time: %.3f ms", stats.pause_time);
+
+            static constexpr double megabyte = 1024.0 * 1024.0;
+            ImGui::Text("Heap: %.2f/%.2f MB", (double)stats.used_size / megabyte,
+                        (double)stats.heap_size / megabyte);
         }
 
         if (ImGui::CollapsingHeader("Device info")) {